@@ -11,6 +11,7 @@
 #include <bsp/esp-bsp.h>
 #include <esp_err.h>
 #include <esp_log.h>
+#include <esp_timer.h>
 #include <esp_matter.h>
 #include <esp_matter_console.h>
 #include <esp_matter_ota.h>
@@ -31,6 +32,17 @@
 #include <tasks/dht11_task.h>
 #include <tasks/soil_task.h>
 #include <tasks/firebase.h>
+#include <tasks/fb_stream.h>
+#include <tasks/sensor_sched.h>
+#include <tasks/report_policy.h>
+#include <tasks/history.h>
+#include <tasks/latency.h>
+#include <tasks/matter_batch.h>
+#include <tasks/health.h>
+#include <tasks/sensor_bus.h>
+#include <tasks/wall_clock.h>
+#include <ep_registry.h>
+#include <app_memory.h>
 
 
 
@@ -48,68 +60,108 @@ uint16_t led_ep_id;
 uint16_t water_pump_ep_id;
 uint16_t heat_led_ep_id;
 uint16_t dht11_ep_ids[2];
+uint16_t cds_ep_id;
+uint16_t soil_ep_id;
 
+// 측정값별 보고 정책: 이 이상 바뀌었거나 max interval이 지났을 때만 Matter/Firebase로 보냄
+// { abs deadband, rel deadband, min interval ms, max interval ms }
+// deadband는 key 테이블(fb_keys.h) 값 사용
+static constexpr report_policy_t key_policy(fb_key_t key)
+{
+    return { fb_key_info(key).abs_deadband, fb_key_info(key).rel_deadband, 0, 10 * 60 * 1000 };
+}
+
+struct key_policies_t {
+    report_policy_t p[FB_KEY_COUNT];
+};
 
-// Application cluster specification, 7.18.2.11. Temperature
-// represents a temperature on the Celsius scale with a resolution of 0.01°C.
-// temp = (temperature in °C) x 100
-void temp_sensor_notification(uint16_t endpoint_id, float temp, void *user_data)
+static constexpr key_policies_t make_key_policies()
 {
-    // schedule the attribute update so that we can report it from matter thread
-    chip::DeviceLayer::SystemLayer().ScheduleLambda([endpoint_id, temp]() {
-        attribute_t * attribute = attribute::get(endpoint_id,
-                                                 TemperatureMeasurement::Id,
-                                                 TemperatureMeasurement::Attributes::MeasuredValue::Id);
+    key_policies_t t{};
+    for (int k = 0; k < FB_KEY_COUNT; k++) t.p[k] = key_policy(static_cast<fb_key_t>(k));
+    return t;
+}
 
-        esp_matter_attr_val_t val = esp_matter_invalid(NULL);
-        attribute::get_val(attribute, &val);
-        val.val.i16 = static_cast<int16_t>(temp * 100);
+static constexpr key_policies_t s_key_policies = make_key_policies();
 
-        attribute::update(endpoint_id, TemperatureMeasurement::Id, TemperatureMeasurement::Attributes::MeasuredValue::Id, &val);
-    });
-    fb_update("temperature",temp);
+// endpoint가 있는 측정값 (health 같은 진단 값은 bus를 거치지 않음)
+static constexpr uint32_t s_measure_keys =
+    SENSOR_KEY_BIT(FB_KEY_TEMPERATURE) | SENSOR_KEY_BIT(FB_KEY_HUMIDITY) |
+    SENSOR_KEY_BIT(FB_KEY_SOIL_MOISTURE) | SENSOR_KEY_BIT(FB_KEY_LIGHT_INTENSITY);
+
+// 센서 측정값 bus: producer(센서 샘플 함수)는 전부 sensor scheduler 태스크에서 publish하므로 잠금 없음
+static sensor_bus_t s_sensor_bus;
+
+void sensor_publish(fb_key_t key, uint16_t endpoint_id, float value)
+{
+    sensor_reading_t r = { key, endpoint_id, value, (uint64_t)(esp_timer_get_time() / 1000), 0 };
+    sensor_bus_publish(&s_sensor_bus, &r);
 }
 
-// Application cluster specification, 2.6.4.1. MeasuredValue Attribute
-// represents the humidity in percent.
-// humidity = (humidity in %) x 100
-void humidity_sensor_notification(uint16_t endpoint_id, float humidity, void *user_data)
+// 모든 샘플 -> on-device history
+static void history_sink(const sensor_reading_t *r, void *ctx)
 {
-    // schedule the attribute update so that we can report it from matter thread
-    chip::DeviceLayer::SystemLayer().ScheduleLambda([endpoint_id, humidity]() {
-        attribute_t * attribute = attribute::get(endpoint_id,
-                                                 RelativeHumidityMeasurement::Id,
-                                                 RelativeHumidityMeasurement::Attributes::MeasuredValue::Id);
-
-        esp_matter_attr_val_t val = esp_matter_invalid(NULL);
-        attribute::get_val(attribute, &val);
-        val.val.u16 = static_cast<uint16_t>(humidity * 100);
-
-        attribute::update(endpoint_id, RelativeHumidityMeasurement::Id, RelativeHumidityMeasurement::Attributes::MeasuredValue::Id, &val);
-        
-    });
-    if (endpoint_id == dht11_ep_ids[1]) {
-        fb_update("humidity", humidity);
+    ep_entry_t *e = ep_registry_get(r->endpoint_id);
+    if (e && e->role == EP_ROLE_SENSOR) history_record(e->history, r->value);
+}
+
+// 보고 정책 통과 -> 라운드 끝에 다른 값들과 같이 Matter 스레드에서 적용
+static void matter_sink(const sensor_reading_t *r, void *ctx)
+{
+    ep_entry_t *e = ep_registry_get(r->endpoint_id);
+    if (!e || e->role != EP_ROLE_SENSOR) {
+        ESP_LOGW(TAG, "Unknown sensor endpoint ID %d", r->endpoint_id);
+        return;
     }
-    else {
-        fb_update("soilMoisture",humidity);
+
+    float scaled = r->value * e->attr_scale;
+    if (e->attr_signed) {
+        matter_batch_set_i16(e->attr, static_cast<int16_t>(scaled));
+    } else {
+        matter_batch_set_u16(e->attr, static_cast<uint16_t>(scaled));
     }
-    
 }
 
-// cds cluster specification
-void cds_sensor_notification(uint16_t endpoint_id, float illuminance, void *user_data){
-    chip::DeviceLayer::SystemLayer().ScheduleLambda([endpoint_id, illuminance](){
-        attribute_t *attribute = attribute::get(endpoint_id, IlluminanceMeasurement::Id, IlluminanceMeasurement::Attributes::MeasuredValue::Id);
-    esp_matter_attr_val_t val = esp_matter_invalid(NULL);
-    attribute::get_val(attribute, &val);
-    val.val.u16 = static_cast<uint16_t>(illuminance);
+// 보고 정책 통과 -> Firebase key 슬롯
+static void firebase_sink(const sensor_reading_t *r, void *ctx)
+{
+    fb_update(r->key, r->value);
+}
 
-    attribute::update(endpoint_id, IlluminanceMeasurement::Id, IlluminanceMeasurement::Attributes::MeasuredValue::Id, &val);
-    });
-    fb_update("lightIntensity",illuminance);
-};
+// sensor scheduler 콜백: sink별 전달 / filter / 보고 정책 억제 수
+static void sensor_bus_report(void *ctx)
+{
+    for (int i = 0; i < s_sensor_bus.count; i++) {
+        const sensor_sub_t *sub = &s_sensor_bus.subs[i];
+        ESP_LOGI(TAG, "bus %-8s delivered=%lu filtered=%lu limited=%lu", sub->cfg.name,
+                 (unsigned long)sub->delivered, (unsigned long)sub->filtered, (unsigned long)sub->limited);
+    }
+}
+
+static void sensor_bus_setup(void)
+{
+    static const sensor_sub_cfg_t subs[] = {
+        { "history",  history_sink,  NULL, s_measure_keys, NULL },
+        { "matter",   matter_sink,   NULL, s_measure_keys, s_key_policies.p },
+        { "firebase", firebase_sink, NULL, s_measure_keys, s_key_policies.p },
+    };
+    for (const sensor_sub_cfg_t &sub : subs) {
+        if (sensor_bus_subscribe(&s_sensor_bus, &sub) < 0) ESP_LOGE(TAG, "cannot subscribe %s", sub.name);
+    }
+}
+
+// Firebase control 노드에서 온 on/off를 Matter OnOff 속성 갱신으로 적용
+// (드라이버 구동과 Firebase 상태 보고는 app_attribute_update_cb가 그대로 처리)
+static void remote_control_apply(fb_key_t key, bool on)
+{
+    uint16_t endpoint_id = ep_registry_endpoint_of(key);
+    if (endpoint_id == 0) return;
 
+    chip::DeviceLayer::SystemLayer().ScheduleLambda([endpoint_id, on]() {
+        esp_matter_attr_val_t val = esp_matter_bool(on);
+        attribute::update(endpoint_id, OnOff::Id, OnOff::Attributes::OnOff::Id, &val);
+    });
+}
 
 static esp_err_t factory_reset_button_register()
 {
@@ -199,17 +251,10 @@ static esp_err_t app_attribute_update_cb(attribute::callback_type_t type,
     // }
     if (type == PRE_UPDATE && cluster_id == OnOff::Id && attribute_id == OnOff::Attributes::OnOff::Id){
 
-        if (endpoint_id == led_ep_id) {
-            led_driver_set_power(val->val.b);
-            fb_update("ledStatus", val->val.b ? 1:0);
-        }
-        else if (endpoint_id == heat_led_ep_id) {
-            heat_led_driver_set_power(val->val.b);
-            fb_update("heatLedStatus", val->val.b ? 1:0);
-        }
-        else if (endpoint_id == water_pump_ep_id) {
-            water_pump_driver_set_power(val->val.b);
-            fb_update("pumpStatus", val->val.b ? 1:0);
+        ep_entry_t *e = ep_registry_get(endpoint_id);
+        if (e && e->role == EP_ROLE_ACTUATOR) {
+            e->set_power(val->val.b);
+            fb_update(e->key, val->val.b ? 1:0);
         }
         else {
             ESP_LOGW(TAG, "Unknown endpoint ID %d for OnOff", endpoint_id);
@@ -226,9 +271,18 @@ extern "C" void app_main()
     /* Initialize the ESP NVS layer */
     nvs_flash_init();
 
+    /* Boot counter (stamps records made before SNTP sync) */
+    wall_clock_init();
+
     /* Initialize queue*/
     fb_queue_init();
 
+    /* Initialize on-device sensor history */
+    history_init();
+
+    /* Measure latency instrumentation cost */
+    latency_init();
+
     /* Initialize push button on the dev-kit to reset the device */
     esp_err_t err = factory_reset_button_register();
     ABORT_APP_ON_FAILURE(ESP_OK == err, ESP_LOGE(TAG, "Failed to initialize reset button, err:%d", err));
@@ -307,22 +361,97 @@ extern "C" void app_main()
     water_pump_ep_id = endpoint::get_id(water_pump_ep);
 
     // cds endpoint id
-    uint16_t cds_ep_id = endpoint::get_id(cds_ep);
+    cds_ep_id = endpoint::get_id(cds_ep);
 
     // dht11 endpoint id
     dht11_ep_ids[0] = endpoint::get_id(dht11_temp_ep);
     dht11_ep_ids[1] = endpoint::get_id(dht11_humidity_ep);
 
     // soil moisture sensor endpoint id
-    uint16_t soil_ep_id = endpoint::get_id(soil_humidity_ep);
+    soil_ep_id = endpoint::get_id(soil_humidity_ep);
+
+    // endpoint registry: 모든 콜백과 sensor bus sink가 endpoint id로 역할/드라이버/key/속성을 찾음
+    ep_entry_t *ep;
+    ep = ep_registry_add_actuator(led_ep_id, FB_KEY_LED_STATUS, led_driver_set_power);
+    ABORT_APP_ON_FAILURE(ep != nullptr, ESP_LOGE(TAG, "Failed to register led endpoint %u", led_ep_id));
+    ep = ep_registry_add_actuator(heat_led_ep_id, FB_KEY_HEAT_LED_STATUS, heat_led_driver_set_power);
+    ABORT_APP_ON_FAILURE(ep != nullptr, ESP_LOGE(TAG, "Failed to register heat led endpoint %u", heat_led_ep_id));
+    ep = ep_registry_add_actuator(water_pump_ep_id, FB_KEY_PUMP_STATUS, water_pump_driver_set_power);
+    ABORT_APP_ON_FAILURE(ep != nullptr, ESP_LOGE(TAG, "Failed to register pump endpoint %u", water_pump_ep_id));
+
+    // MeasuredValue: 온도/습도는 x100, 조도는 lux 그대로. 속성 handle은 여기서 한 번만 찾음
+    ep = ep_registry_add_sensor(dht11_ep_ids[0], FB_KEY_TEMPERATURE, HISTORY_TEMPERATURE, 100, true);
+    ABORT_APP_ON_FAILURE(ep != nullptr, ESP_LOGE(TAG, "Failed to register temperature endpoint %u", dht11_ep_ids[0]));
+    ep->attr = matter_batch_bind(dht11_ep_ids[0], TemperatureMeasurement::Id,
+                                 TemperatureMeasurement::Attributes::MeasuredValue::Id);
+    ABORT_APP_ON_FAILURE(ep->attr >= 0, ESP_LOGE(TAG, "Failed to bind temperature MeasuredValue on endpoint %u", dht11_ep_ids[0]));
+    ep = ep_registry_add_sensor(dht11_ep_ids[1], FB_KEY_HUMIDITY, HISTORY_HUMIDITY, 100, false);
+    ABORT_APP_ON_FAILURE(ep != nullptr, ESP_LOGE(TAG, "Failed to register humidity endpoint %u", dht11_ep_ids[1]));
+    ep->attr = matter_batch_bind(dht11_ep_ids[1], RelativeHumidityMeasurement::Id,
+                                 RelativeHumidityMeasurement::Attributes::MeasuredValue::Id);
+    ABORT_APP_ON_FAILURE(ep->attr >= 0, ESP_LOGE(TAG, "Failed to bind humidity MeasuredValue on endpoint %u", dht11_ep_ids[1]));
+    ep = ep_registry_add_sensor(soil_ep_id, FB_KEY_SOIL_MOISTURE, HISTORY_SOIL_MOISTURE, 100, false);
+    ABORT_APP_ON_FAILURE(ep != nullptr, ESP_LOGE(TAG, "Failed to register soil endpoint %u", soil_ep_id));
+    ep->attr = matter_batch_bind(soil_ep_id, RelativeHumidityMeasurement::Id,
+                                 RelativeHumidityMeasurement::Attributes::MeasuredValue::Id);
+    ABORT_APP_ON_FAILURE(ep->attr >= 0, ESP_LOGE(TAG, "Failed to bind soil MeasuredValue on endpoint %u", soil_ep_id));
+    ep = ep_registry_add_sensor(cds_ep_id, FB_KEY_LIGHT_INTENSITY, HISTORY_LIGHT, 1, false);
+    ABORT_APP_ON_FAILURE(ep != nullptr, ESP_LOGE(TAG, "Failed to register light endpoint %u", cds_ep_id));
+    ep->attr = matter_batch_bind(cds_ep_id, IlluminanceMeasurement::Id,
+                                 IlluminanceMeasurement::Attributes::MeasuredValue::Id);
+    ABORT_APP_ON_FAILURE(ep->attr >= 0, ESP_LOGE(TAG, "Failed to bind light MeasuredValue on endpoint %u", cds_ep_id));
+
+    // 측정값 sink: history (모든 샘플), Matter / Firebase (key별 보고 정책)
+    sensor_bus_setup();
 
     /* Matter start */
     err = esp_matter::start(app_event_cb);
     ABORT_APP_ON_FAILURE(err == ESP_OK, ESP_LOGE(TAG, "Failed to start Matter, err:%d", err));
+
+    /* Wall clock for offline records / history rollups (network stack is up now) */
+    wall_clock_start_sntp();
+
+#if CONFIG_ENABLE_CHIP_SHELL
+    esp_matter::console::diagnostics_register_commands();
+    esp_matter::console::wifi_register_commands();
+    firebase_register_commands();
+    history_register_commands();
+    latency_register_commands();
+    sensor_sched_register_commands();
+    health_register_commands();
+    app_memory_register_commands();
+    esp_matter::console::init();
+#endif
     
-    xTaskCreate(firebase_control_task, "fb_control", 4096, NULL, 6, NULL); 
-    xTaskCreate(dht11_task, "dht11_task", 4096, dht11_ep_ids, 5, NULL);
-    xTaskCreate(soil_moisture_task, "soil_moisture_task", 4096, &soil_ep_id, 5, NULL);
-    xTaskCreate(cds_task, "cds task", 4096, &cds_ep_id, 5, NULL);
-    xTaskCreate(firebase_sensor_task,  "fb_sensor",  4096, NULL, 4, NULL); 
+    // control/sensor lane 모두 태스크 하나, TLS 세션 하나로 업로드
+    firebase_uploader_start();
+
+    // 앱에서 control 노드를 바꾸면 바로 반영 (SSE)
+    fb_stream_start(remote_control_apply);
+
+    // 센서는 전부 스케줄러 태스크 하나에서 주기마다 샘플링 (칸이 모자라면 SCHED_MAX_ENTRIES)
+    const struct {
+        const char *name;
+        sched_fn_t  fn;
+        void       *ctx;
+        uint32_t    period_ms;
+    } sched_entries[] = {
+        { "dht11",         dht11_sample,         dht11_ep_ids, 20000 },
+        { "soil_moisture", soil_moisture_sample, &soil_ep_id,  10000 },
+        { "cds",           cds_sample,           &cds_ep_id,   10000 },
+        { "health",        health_sample,        NULL,         60 * 1000 },
+        { "latency",       latency_report,       NULL,         5 * 60 * 1000 },
+        { "matter_batch",  matter_batch_report,  NULL,         5 * 60 * 1000 },
+        { "sensor_bus",    sensor_bus_report,    NULL,         5 * 60 * 1000 },
+        { "sched",         sensor_sched_report,  NULL,         5 * 60 * 1000 },
+    };
+    for (const auto &e : sched_entries) {
+        ABORT_APP_ON_FAILURE(sensor_sched_register(e.name, e.fn, e.ctx, e.period_ms) >= 0,
+                             ESP_LOGE(TAG, "Failed to register %s with the sensor scheduler", e.name));
+    }
+    sensor_sched_set_round_hook(matter_batch_flush);
+    sensor_sched_start();
+
+    // 정적 RAM map + 태스크 시작 후 heap 상태 (예산은 빌드 때 확인)
+    app_memory_report();
 }
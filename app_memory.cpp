@@ -0,0 +1,104 @@
+#include "app_memory.h"
+#include "app_memory_config.h"
+#include "sdkconfig.h"
+#include <esp_log.h>
+#include <esp_heap_caps.h>
+#include <stdio.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+#include <drivers/dht.h>
+#include <tasks/adc_shared.h>
+#include <tasks/fb_offline.h>
+#include <tasks/fb_stream.h>
+#include <tasks/firebase.h>
+#include <tasks/history.h>
+#include <tasks/latency.h>
+#include <tasks/matter_batch.h>
+#include <tasks/sensor_bus.h>
+#include <tasks/sensor_sched.h>
+#include <ep_registry.h>
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+static const char *TAG = "memmap";
+
+// 모듈마다 header의 정적 RAM 상한 (모듈 소스가 실제 sizeof 합을 static_assert로 확인).
+// 몇 byte짜리 상태 변수만 있는 모듈 (fb_dns, health, wall_clock, 센서 filter, GPIO 드라이버) 은 뺌
+static constexpr app_mem_region_t s_map[] = {
+    {"firebase",        FIREBASE_STATIC_BYTES},
+    {"fb_offline",      FB_OFFLINE_STATIC_BYTES},
+    {"fb_stream",       FB_STREAM_STATIC_BYTES},
+    {"sensor_sched",    SENSOR_SCHED_STATIC_BYTES},
+    {"sensor bus",      sizeof(sensor_bus_t)},  // app_main.cpp
+    {"matter_batch",    MATTER_BATCH_STATIC_BYTES},
+    {"ep_registry",     EP_REGISTRY_STATIC_BYTES},
+    {"history",         HISTORY_STATIC_BYTES},
+#if CONFIG_ENABLE_CHIP_SHELL
+    {"history console", sizeof(hist_ring_t)},
+#endif
+    {"latency",         LATENCY_STATIC_BYTES},
+    {"adc_shared",      ADC_SHARED_STATIC_BYTES},
+    {"dht",             DHT_STATIC_BYTES},
+};
+static constexpr int s_map_count = sizeof(s_map) / sizeof(s_map[0]);
+
+static constexpr size_t map_total(int i = 0)
+{
+    return i < s_map_count ? s_map[i].bytes + map_total(i + 1) : 0;
+}
+
+static_assert(map_total() <= APP_STATIC_RAM_BUDGET,
+              "static RAM map exceeds APP_STATIC_RAM_BUDGET (app_memory_config.h)");
+
+const app_mem_region_t *app_memory_map(int *count)
+{
+    if (count) *count = s_map_count;
+    return s_map;
+}
+
+void app_memory_report(void)
+{
+    for (int i = 0; i < s_map_count; i++) {
+        ESP_LOGI(TAG, "%-20s %6u", s_map[i].name, (unsigned)s_map[i].bytes);
+    }
+    ESP_LOGI(TAG, "static total %u / %u bytes, heap free %u largest %u",
+             (unsigned)map_total(), (unsigned)APP_STATIC_RAM_BUDGET,
+             (unsigned)heap_caps_get_free_size(MALLOC_CAP_8BIT),
+             (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+
+static esp_err_t memmap_cmd(int argc, char **argv)
+{
+    for (int i = 0; i < s_map_count; i++) {
+        printf("%-20s %6u\n", s_map[i].name, (unsigned)s_map[i].bytes);
+    }
+    printf("static total %u / %u bytes\n", (unsigned)map_total(), (unsigned)APP_STATIC_RAM_BUDGET);
+    printf("heap free %u min %u largest %u\n",
+           (unsigned)heap_caps_get_free_size(MALLOC_CAP_8BIT),
+           (unsigned)heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT),
+           (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+    return ESP_OK;
+}
+
+void app_memory_register_commands(void)
+{
+    static const esp_matter::console::command_t cmds[] = {
+        { "memmap", "Static RAM map and heap state. Usage: memmap", memmap_cmd },
+    };
+    esp_matter::console::add_commands(cmds, sizeof(cmds) / sizeof(cmds[0]));
+}
+
+#else
+
+void app_memory_register_commands(void)
+{
+}
+
+#endif
@@ -0,0 +1,27 @@
+#pragma once
+
+// 정적 할당 RAM map (크기는 app_memory_config.h). 모듈 header의 정적 RAM 상한을 빌드 때 합해서 예산과 비교
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    const char *name;
+    size_t      bytes;
+} app_mem_region_t;
+
+// RAM map 표와 항목 수
+const app_mem_region_t *app_memory_map(int *count);
+
+// RAM map + 현재 heap 상태 로그 (app_main에서 부팅 때 한 번)
+void app_memory_report(void);
+
+// "memmap" console 명령 등록 (CONFIG_ENABLE_CHIP_SHELL일 때만)
+void app_memory_register_commands(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,42 @@
+#pragma once
+
+// 오래 사는 객체(태스크 stack/TCB, 세마포어, 통신 버퍼)의 크기를 한 곳에서 관리.
+// 모두 정적 할당이라 부팅 후 heap은 Matter / OTA / esp_http_client 내부 할당만 사용함.
+// 각 모듈 header가 자기 정적 객체의 상한(<MODULE>_STATIC_BYTES)을 이 값들로 정하고 모듈 소스가 실제 sizeof 합을
+// static_assert로 확인함. app_memory.cpp가 상한을 합해서 APP_STATIC_RAM_BUDGET을 넘으면 빌드가 실패함.
+
+/* 태스크: stack 크기 (byte), 우선순위 */
+#define APP_FB_UPLOADER_STACK    4096
+#define APP_FB_UPLOADER_PRIO     6
+#define APP_FB_STREAM_STACK      6144
+#define APP_FB_STREAM_PRIO       5
+#define APP_SENSOR_SCHED_STACK   4096
+#define APP_SENSOR_SCHED_PRIO    5
+
+/* 태스크 하나의 정적 영역 (stack + TCB). freertos/FreeRTOS.h를 include한 곳에서 펼쳐짐 */
+#define APP_TASK_BYTES(stack)    ((size_t)(stack) * sizeof(StackType_t) + sizeof(StaticTask_t))
+
+/* Firebase uploader 연결 버퍼 (fb_conn_t 안에 들어감) */
+#define APP_FB_BODY_LEN          384   // 요청 body (batch 하나)
+#define APP_FB_RESP_LEN          128   // 응답 body (에러 메시지 로그용)
+#define APP_FB_URL_LEN           128   // https://<ip>/<path>
+
+/* esp_http_client 내부 rx/tx 버퍼: client를 유지하므로 연결마다가 아니라 init 때 한 번 할당 */
+#define APP_FB_HTTP_RX_BUF       1024
+#define APP_FB_HTTP_TX_BUF       512
+
+/* SSE 스트림 */
+#define APP_FB_STREAM_READ_LEN   256
+
+/* ADC DMA 프레임 (byte, 2 byte/sample) */
+#define APP_ADC_FRAME_SIZE       256
+
+/* ADC raw -> mV 테이블 개수 (사용하는 감쇠 수) */
+#define APP_ADC_LUT_COUNT        1
+
+/* 모듈 정적 객체 전체의 상한 (byte). 기본 설정에서 모듈 상한의 합은 약 50 KB (console 포함):
+ * 태스크 3개 ~15.5 KB, firebase 버퍼 + replay batch ~7.5 KB, history ring 9 KB (+ console 복사본 2.2 KB),
+ * ADC mV 테이블 + ring ~9.6 KB, sensor bus 2.4 KB, 나머지 ~2 KB.
+ * 예전 48 KB는 태스크 / 연결 버퍼 / history / ADC 테이블만 세던 때의 값이라 replay batch, sensor bus,
+ * schedule heap, ADC ring, console 복사본이 빠져 있었음. 버퍼는 replay body (+0.4 KB) 말고는 그대로. 56 KB = 약 50 KB + 여유 ~5 KB */
+#define APP_STATIC_RAM_BUDGET    (56 * 1024)
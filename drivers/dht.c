@@ -39,18 +39,21 @@
  * BSD Licensed as described in the file LICENSE
  */
 #include "dht.h"
+#include "dht_decode.h"
 
 #include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
 #include <string.h>
 #include <esp_log.h>
 #include <esp_rom_sys.h>
+#include <esp_timer.h>
+#include "sdkconfig.h"
 //#include <ets_sys.h>
 //#include <esp_idf_lib_helpers.h>
 
 // DHT timer precision in microseconds
 #define DHT_TIMER_INTERVAL 2
-#define DHT_DATA_BITS 40
-#define DHT_DATA_BYTES (DHT_DATA_BITS / 8)
 #define HELPER_TARGET_IS_ESP32 1
 
 
@@ -106,6 +109,103 @@ static portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
     } while (0)
 
 
+#if CONFIG_DHT_CAPTURE_EDGE_ISR
+
+// release edge + response + 40 bits + the sensor's final release
+#define DHT_MAX_EDGES (DHT_EDGE_COUNT + 1)
+// the whole transaction is ~5 ms after phase 'A'
+#define DHT_CAPTURE_TIMEOUT_MS 10
+
+typedef struct
+{
+    uint32_t edges[DHT_MAX_EDGES];
+    volatile size_t count;
+    SemaphoreHandle_t done;
+    StaticSemaphore_t done_mem;
+} dht_capture_t;
+
+static dht_capture_t capture;
+
+static void IRAM_ATTR dht_edge_isr(void *arg)
+{
+    dht_capture_t *cap = (dht_capture_t *)arg;
+    size_t n = cap->count;
+
+    if (n < DHT_MAX_EDGES)
+    {
+        cap->edges[n] = (uint32_t)esp_timer_get_time();
+        cap->count = ++n;
+    }
+    if (n == DHT_MAX_EDGES)
+    {
+        BaseType_t woken = pdFALSE;
+        xSemaphoreGiveFromISR(cap->done, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+}
+
+/**
+ * Request data from DHT and timestamp every edge of the reply from a GPIO
+ * interrupt. Phase 'A' is a task delay and the bit stream arrives while the
+ * calling task is blocked, so no critical section is held and the CPU is
+ * free during the whole transaction. Bits are decoded afterwards by
+ * dht_decode_edges().
+ * Not reentrant: only one capture may be in flight at a time.
+ */
+static esp_err_t dht_capture_data(dht_sensor_type_t sensor_type, gpio_num_t pin, uint8_t data[DHT_DATA_BYTES])
+{
+    esp_err_t res = gpio_install_isr_service(0);
+    if (res != ESP_OK && res != ESP_ERR_INVALID_STATE)
+        return res;
+
+    if (!capture.done)
+    {
+        capture.done = xSemaphoreCreateBinaryStatic(&capture.done_mem);
+    }
+    xSemaphoreTake(capture.done, 0);
+    capture.count = 0;
+
+    // Phase 'A' pulling signal low to initiate read sequence
+    gpio_set_direction(pin, GPIO_MODE_INPUT_OUTPUT_OD);
+    gpio_set_level(pin, 0);
+    if (sensor_type == DHT_TYPE_SI7021)
+        esp_rom_delay_us(500);
+    else
+        vTaskDelay(pdMS_TO_TICKS(20) + 1);  // +1: at least 20 ms whatever the tick phase
+
+    // the release edge below is edges[0]
+    gpio_set_intr_type(pin, GPIO_INTR_ANYEDGE);
+    res = gpio_isr_handler_add(pin, dht_edge_isr, &capture);
+    if (res != ESP_OK)
+        return res;
+    gpio_intr_enable(pin);
+    gpio_set_level(pin, 1);
+
+    // a reply without the final release edge ends on the timeout
+    xSemaphoreTake(capture.done, pdMS_TO_TICKS(DHT_CAPTURE_TIMEOUT_MS) + 1);
+
+    gpio_intr_disable(pin);
+    gpio_isr_handler_remove(pin);
+    gpio_set_intr_type(pin, GPIO_INTR_DISABLE);
+
+    switch (dht_decode_edges(capture.edges, capture.count, data))
+    {
+        case DHT_DECODE_OK:
+            return ESP_OK;
+        case DHT_DECODE_SHORT:
+            ESP_LOGE(TAG, "Timeout, only %u edges captured", (unsigned)capture.count);
+            return ESP_ERR_TIMEOUT;
+        case DHT_DECODE_BAD_RESPONSE:
+            ESP_LOGE(TAG, "Initialization error, bad response timing");
+            return ESP_ERR_INVALID_RESPONSE;
+        default:
+            ESP_LOGE(TAG, "Bit timing out of range");
+            return ESP_ERR_INVALID_RESPONSE;
+    }
+}
+
+#else  // polling reader
+
 /**
  * Wait specified time for pin to go to a specified state.
  * If timeout is reached and pin doesn't go to a requested state
@@ -180,6 +280,12 @@ static inline esp_err_t dht_fetch_data(dht_sensor_type_t sensor_type, gpio_num_t
     return ESP_OK;
 }
 
+#endif  // CONFIG_DHT_CAPTURE_EDGE_ISR
+
+#if CONFIG_DHT_CAPTURE_EDGE_ISR
+_Static_assert(sizeof(capture) <= DHT_STATIC_BYTES, "dht.c capture buffer outgrew DHT_STATIC_BYTES (dht.h)");
+#endif
+
 /**
  * Pack two data bytes into single value and take into account sign bit.
  */
@@ -213,10 +319,14 @@ esp_err_t dht_read_data(dht_sensor_type_t sensor_type, gpio_num_t pin,
     gpio_set_direction(pin, GPIO_MODE_OUTPUT_OD);
     gpio_set_level(pin, 1);
 
+#if CONFIG_DHT_CAPTURE_EDGE_ISR
+    esp_err_t result = dht_capture_data(sensor_type, pin, data);
+#else
     PORT_ENTER_CRITICAL();
     esp_err_t result = dht_fetch_data(sensor_type, pin, data);
     if (result == ESP_OK)
         PORT_EXIT_CRITICAL();
+#endif
 
     /* restore GPIO direction because, after calling dht_fetch_data(), the
      * GPIO direction mode changes */
@@ -226,7 +336,7 @@ esp_err_t dht_read_data(dht_sensor_type_t sensor_type, gpio_num_t pin,
     if (result != ESP_OK)
         return result;
 
-    if (data[4] != ((data[0] + data[1] + data[2] + data[3]) & 0xFF))
+    if (!dht_checksum_ok(data))
     {
         ESP_LOGE(TAG, "Checksum failed, invalid data received from sensor");
         return ESP_ERR_INVALID_CRC;
@@ -46,8 +46,11 @@
 #ifndef __DHT_H__
 #define __DHT_H__
 
+#include <stddef.h>
 #include <driver/gpio.h>
 #include <esp_err.h>
+#include "sdkconfig.h"
+#include "dht_decode.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -92,6 +95,15 @@ esp_err_t dht_read_data(dht_sensor_type_t sensor_type, gpio_num_t pin,
 esp_err_t dht_read_float_data(dht_sensor_type_t sensor_type, gpio_num_t pin,
         float *humidity, float *temperature);
 
+/**
+ * @brief Upper bound of the driver's static RAM (edge capture buffer, its semaphore, count/handle)
+ */
+#if CONFIG_DHT_CAPTURE_EDGE_ISR
+#define DHT_STATIC_BYTES ((DHT_EDGE_COUNT + 1) * sizeof(uint32_t) + sizeof(StaticSemaphore_t) + 24)
+#else
+#define DHT_STATIC_BYTES 0
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,53 @@
+/**
+ * @file dht_decode.c
+ *
+ * Edge-timestamp decoder for DHT11/AM2301/Si7021, see dht_decode.h
+ */
+#include "dht_decode.h"
+
+#include <string.h>
+
+// Upper bounds in microseconds. They are looser than the datasheet because
+// every edge also carries the interrupt entry latency.
+#define DHT_MAX_PHASE_B_US 80
+#define DHT_MAX_PHASE_CD_US 140
+#define DHT_MAX_BIT_LOW_US 100
+#define DHT_MAX_BIT_HIGH_US 120
+
+static inline uint32_t edge_delta(const uint32_t *edges_us, size_t i)
+{
+    return edges_us[i] - edges_us[i - 1];
+}
+
+dht_decode_result_t dht_decode_edges(const uint32_t *edges_us, size_t count,
+        uint8_t data[DHT_DATA_BYTES])
+{
+    if (count < DHT_EDGE_COUNT)
+        return DHT_DECODE_SHORT;
+
+    // edges 1..3: end of phases 'B' (sensor pulls low), 'C' and 'D'
+    if (edge_delta(edges_us, 1) > DHT_MAX_PHASE_B_US
+            || edge_delta(edges_us, 2) > DHT_MAX_PHASE_CD_US
+            || edge_delta(edges_us, 3) > DHT_MAX_PHASE_CD_US)
+        return DHT_DECODE_BAD_RESPONSE;
+
+    memset(data, 0, DHT_DATA_BYTES);
+    for (int i = 0; i < DHT_DATA_BITS; i++)
+    {
+        size_t rise = 4 + 2 * i;
+        uint32_t low_duration = edge_delta(edges_us, rise);
+        uint32_t high_duration = edge_delta(edges_us, rise + 1);
+
+        if (low_duration > DHT_MAX_BIT_LOW_US || high_duration > DHT_MAX_BIT_HIGH_US)
+            return DHT_DECODE_BAD_BIT;
+
+        data[i / 8] |= (high_duration > low_duration) << (7 - i % 8);
+    }
+
+    return DHT_DECODE_OK;
+}
+
+int dht_checksum_ok(const uint8_t data[DHT_DATA_BYTES])
+{
+    return data[4] == ((data[0] + data[1] + data[2] + data[3]) & 0xFF);
+}
@@ -0,0 +1,66 @@
+/**
+ * @file dht_decode.h
+ *
+ * Decoder for a DHT transaction captured as edge timestamps.
+ *
+ * Pure C with no ESP-IDF dependencies, so recorded or synthetic waveforms
+ * can be fed to it off-target.
+ */
+#ifndef __DHT_DECODE_H__
+#define __DHT_DECODE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DHT_DATA_BITS 40
+#define DHT_DATA_BYTES (DHT_DATA_BITS / 8)
+
+/**
+ * Edges in a complete capture: the MCU releasing the line after phase 'A',
+ * the three response edges of phases 'B'-'D' and a rising/falling pair for
+ * every data bit. The sensor's final release edge is optional.
+ */
+#define DHT_EDGE_COUNT (1 + 3 + 2 * DHT_DATA_BITS)
+
+typedef enum
+{
+    DHT_DECODE_OK = 0,        //!< All 40 bits decoded
+    DHT_DECODE_SHORT,         //!< Fewer edges than a full transaction
+    DHT_DECODE_BAD_RESPONSE,  //!< Phase 'B', 'C' or 'D' out of range
+    DHT_DECODE_BAD_BIT,       //!< A bit's low or high time out of range
+} dht_decode_result_t;
+
+/**
+ * @brief Decode raw sensor bytes from edge timestamps
+ *
+ * `edges_us[0]` must be the line release at the end of phase 'A' and each
+ * following entry the time of the next level change, in microseconds.
+ * Timestamps may wrap; only differences between neighbours are used.
+ * A bit is '1' when its high time is longer than its low time, the same
+ * rule as the polling reader.
+ *
+ * @param edges_us Edge timestamps in microseconds
+ * @param count Number of entries in `edges_us`
+ * @param[out] data Decoded bytes (checksum is not verified)
+ * @return `DHT_DECODE_OK` on success
+ */
+dht_decode_result_t dht_decode_edges(const uint32_t *edges_us, size_t count,
+        uint8_t data[DHT_DATA_BYTES]);
+
+/**
+ * @brief Check the fifth byte against the sum of the first four
+ *
+ * @param data Bytes from dht_decode_edges()
+ * @return non-zero when the checksum matches
+ */
+int dht_checksum_ok(const uint8_t data[DHT_DATA_BYTES]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __DHT_DECODE_H__
@@ -0,0 +1,114 @@
+// dht_decode_edges(): 합성 파형 (정상 / 응답 이상 / bit 이상 / 잘린 capture)과 checksum
+#include "host_check.h"
+#include "dht_decode.h"
+#include <string.h>
+
+// bit 하나: low 50 us 뒤 high 26 us ('0') 또는 70 us ('1') (DHT11 datasheet)
+#define BIT_LOW_US   50
+#define BIT0_HIGH_US 26
+#define BIT1_HIGH_US 70
+
+typedef struct {
+    uint32_t edges[DHT_EDGE_COUNT + 1];
+    size_t   count;
+} wave_t;
+
+// 5 byte를 edge timestamp 로 (t0 = phase 'A' 끝의 release). release edge 포함
+static void make_wave(wave_t *w, const uint8_t bytes[DHT_DATA_BYTES], uint32_t t0)
+{
+    uint32_t t = t0;
+    size_t n = 0;
+    w->edges[n++] = t;
+    w->edges[n++] = t += 30;   // 'B': sensor가 low로 당김
+    w->edges[n++] = t += 80;   // 'C'
+    w->edges[n++] = t += 80;   // 'D'
+    for (int i = 0; i < DHT_DATA_BITS; i++) {
+        bool one = bytes[i / 8] & (0x80 >> (i % 8));
+        w->edges[n++] = t += BIT_LOW_US;
+        w->edges[n++] = t += one ? BIT1_HIGH_US : BIT0_HIGH_US;
+    }
+    w->edges[n++] = t += BIT_LOW_US;  // 마지막 release
+    w->count = n;
+}
+
+// 뒤 edge를 모두 delta 만큼 밀어서 edge i 앞 구간 길이를 바꿈
+static void stretch(wave_t *w, size_t i, int32_t delta)
+{
+    for (size_t j = i; j < w->count; j++) w->edges[j] += delta;
+}
+
+int main()
+{
+    // 습도 45.6 %, 온도 23.1 C (DHT11: 정수부 / 소수부)
+    const uint8_t good[DHT_DATA_BYTES] = { 45, 6, 23, 1, 45 + 6 + 23 + 1 };
+    uint8_t data[DHT_DATA_BYTES];
+    wave_t w;
+
+    make_wave(&w, good, 1000);
+    CHECK_EQ(w.count, DHT_EDGE_COUNT + 1);
+    CHECK_EQ(dht_decode_edges(w.edges, w.count, data), DHT_DECODE_OK);
+    CHECK(memcmp(data, good, sizeof(good)) == 0);
+    CHECK(dht_checksum_ok(data));
+
+    // 마지막 release edge 없이도 (timeout으로 끝난 capture) 40 bit가 다 있으면 OK
+    CHECK_EQ(dht_decode_edges(w.edges, DHT_EDGE_COUNT, data), DHT_DECODE_OK);
+    CHECK(memcmp(data, good, sizeof(good)) == 0);
+
+    // timestamp가 32 bit에서 넘어가도 차이만 쓰므로 같은 결과
+    make_wave(&w, good, UINT32_MAX - 2000);
+    CHECK_EQ(dht_decode_edges(w.edges, w.count, data), DHT_DECODE_OK);
+    CHECK(memcmp(data, good, sizeof(good)) == 0);
+
+    // 모든 bit 패턴이 그대로 나오는지 (0x00 / 0xFF / 교차)
+    const uint8_t patterns[][DHT_DATA_BYTES] = {
+        { 0x00, 0x00, 0x00, 0x00, 0x00 },
+        { 0xFF, 0xFF, 0xFF, 0xFF, 0xFC },
+        { 0xA5, 0x5A, 0x0F, 0xF0, 0xFE },
+    };
+    for (const auto &p : patterns) {
+        make_wave(&w, p, 42);
+        CHECK_EQ(dht_decode_edges(w.edges, w.count, data), DHT_DECODE_OK);
+        CHECK(memcmp(data, p, sizeof(p)) == 0);
+        CHECK(dht_checksum_ok(data));
+    }
+
+    // checksum: 한 bit만 틀려도 실패
+    make_wave(&w, good, 1000);
+    stretch(&w, 4 + 2 * 6 + 1, BIT1_HIGH_US - BIT0_HIGH_US);  // byte 0 의 bit 1 '0' -> '1'
+    CHECK_EQ(dht_decode_edges(w.edges, w.count, data), DHT_DECODE_OK);
+    CHECK_EQ(data[0], 45 | 2);
+    CHECK(!dht_checksum_ok(data));
+
+    // 응답 (phase 'B' / 'C' / 'D') 이 너무 김: sensor가 없거나 다른 장치가 line을 잡고 있음
+    for (size_t edge = 1; edge <= 3; edge++) {
+        make_wave(&w, good, 1000);
+        stretch(&w, edge, 200);
+        CHECK_EQ(dht_decode_edges(w.edges, w.count, data), DHT_DECODE_BAD_RESPONSE);
+    }
+
+    // bit의 low / high 가 상한을 넘음 (edge 하나를 놓쳐서 두 bit가 합쳐진 경우와 같음)
+    make_wave(&w, good, 1000);
+    stretch(&w, 4 + 2 * 20, 60);          // bit 20 low 110 us
+    CHECK_EQ(dht_decode_edges(w.edges, w.count, data), DHT_DECODE_BAD_BIT);
+    make_wave(&w, good, 1000);
+    stretch(&w, 4 + 2 * 39 + 1, 60);      // 마지막 bit high 130 us
+    CHECK_EQ(dht_decode_edges(w.edges, w.count, data), DHT_DECODE_BAD_BIT);
+
+    // 상한 경계: low 100 / high 120 us 까지는 받음
+    make_wave(&w, good, 1000);
+    stretch(&w, 4, 100 - BIT_LOW_US);
+    CHECK_EQ(dht_decode_edges(w.edges, w.count, data), DHT_DECODE_OK);
+    make_wave(&w, good, 1000);
+    stretch(&w, 5, 120 - BIT0_HIGH_US);   // bit 0 ('0') high 120 us -> '1'로 읽힘
+    CHECK_EQ(dht_decode_edges(w.edges, w.count, data), DHT_DECODE_OK);
+    CHECK_EQ(data[0], 45 | 0x80);
+
+    // timeout: edge가 모자라면 (sensor 응답 없음 / 중간에 끊김) SHORT
+    make_wave(&w, good, 1000);
+    CHECK_EQ(dht_decode_edges(w.edges, 0, data), DHT_DECODE_SHORT);
+    CHECK_EQ(dht_decode_edges(w.edges, 1, data), DHT_DECODE_SHORT);  // release 뒤 응답 없음
+    CHECK_EQ(dht_decode_edges(w.edges, 4, data), DHT_DECODE_SHORT);  // 응답만 오고 data 없음
+    CHECK_EQ(dht_decode_edges(w.edges, DHT_EDGE_COUNT - 1, data), DHT_DECODE_SHORT);
+
+    return host_check_result("test_dht_decode");
+}
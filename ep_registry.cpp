@@ -0,0 +1,53 @@
+#include "ep_registry.h"
+#include <string.h>
+
+static ep_entry_t s_entries[EP_REGISTRY_MAX_ENDPOINTS];
+static uint16_t s_key_endpoint[FB_KEY_COUNT];
+
+static ep_entry_t *claim(uint16_t endpoint_id, fb_key_t key, ep_role_t role)
+{
+    if (endpoint_id == 0 || endpoint_id >= EP_REGISTRY_MAX_ENDPOINTS || (unsigned)key >= FB_KEY_COUNT) return NULL;
+
+    ep_entry_t *e = &s_entries[endpoint_id];
+    if (e->role != EP_ROLE_NONE || s_key_endpoint[key] != 0) return NULL;
+
+    memset(e, 0, sizeof(*e));
+    e->role = role;
+    e->key = key;
+    e->attr = -1;
+    s_key_endpoint[key] = endpoint_id;
+    return e;
+}
+
+ep_entry_t *ep_registry_add_actuator(uint16_t endpoint_id, fb_key_t key, ep_set_power_fn_t set_power)
+{
+    ep_entry_t *e = claim(endpoint_id, key, EP_ROLE_ACTUATOR);
+    if (e) e->set_power = set_power;
+    return e;
+}
+
+ep_entry_t *ep_registry_add_sensor(uint16_t endpoint_id, fb_key_t key, history_id_t history,
+                                   float attr_scale, bool attr_signed)
+{
+    ep_entry_t *e = claim(endpoint_id, key, EP_ROLE_SENSOR);
+    if (!e) return NULL;
+    e->history = history;
+    e->attr_scale = attr_scale;
+    e->attr_signed = attr_signed;
+    return e;
+}
+
+ep_entry_t *ep_registry_get(uint16_t endpoint_id)
+{
+    if (endpoint_id >= EP_REGISTRY_MAX_ENDPOINTS) return NULL;
+    ep_entry_t *e = &s_entries[endpoint_id];
+    return e->role == EP_ROLE_NONE ? NULL : e;
+}
+
+uint16_t ep_registry_endpoint_of(fb_key_t key)
+{
+    return (unsigned)key < FB_KEY_COUNT ? s_key_endpoint[key] : 0;
+}
+
+static_assert(sizeof(s_entries) + sizeof(s_key_endpoint) <= EP_REGISTRY_STATIC_BYTES,
+              "ep_registry.cpp statics outgrew EP_REGISTRY_STATIC_BYTES (ep_registry.h)");
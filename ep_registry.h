@@ -0,0 +1,49 @@
+#pragma once
+
+// endpoint id -> 역할 / 드라이버 / Firebase key / history / Matter 속성.
+// app_main에서 endpoint를 만들면서 채우고, 속성 콜백과 센서 bus sink는 전부 이 표로 분기 (endpoint id로 바로 인덱싱)
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "tasks/fb_keys.h"
+#include "tasks/history.h"
+
+#define EP_REGISTRY_MAX_ENDPOINTS 16   // endpoint id < 이 값 (esp_matter는 1부터 차례로 씀)
+
+typedef enum {
+    EP_ROLE_NONE = 0,
+    EP_ROLE_ACTUATOR,   // OnOff -> set_power
+    EP_ROLE_SENSOR,     // 측정값 -> history / Matter 속성 (sensor bus sink에서)
+} ep_role_t;
+
+typedef void (*ep_set_power_fn_t)(bool on);
+
+typedef struct {
+    ep_role_t role;
+    fb_key_t  key;
+
+    // actuator
+    ep_set_power_fn_t set_power;
+
+    // sensor
+    history_id_t    history;
+    int             attr;         // matter_batch handle (-1이면 Matter 갱신 안 함)
+    bool            attr_signed;  // MeasuredValue 타입 int16 / uint16
+    float           attr_scale;   // Matter 값 = 측정값 * scale
+} ep_entry_t;
+
+// 등록 (app_main에서 Matter start 전에). id가 범위 밖이거나, id나 key가 이미 등록돼 있으면 NULL
+ep_entry_t *ep_registry_add_actuator(uint16_t endpoint_id, fb_key_t key, ep_set_power_fn_t set_power);
+ep_entry_t *ep_registry_add_sensor(uint16_t endpoint_id, fb_key_t key, history_id_t history,
+                                   float attr_scale, bool attr_signed);
+
+// 등록 안 된 endpoint면 NULL
+ep_entry_t *ep_registry_get(uint16_t endpoint_id);
+
+// key를 맡은 endpoint id, 없으면 0 (root endpoint는 등록하지 않음)
+uint16_t ep_registry_endpoint_of(fb_key_t key);
+
+// 이 모듈의 정적 RAM (endpoint 표, key -> endpoint 표). app_memory RAM map 용
+#define EP_REGISTRY_STATIC_BYTES (EP_REGISTRY_MAX_ENDPOINTS * sizeof(ep_entry_t) + FB_KEY_COUNT * sizeof(uint16_t))
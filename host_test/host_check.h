@@ -0,0 +1,67 @@
+#pragma once
+// host 테스트용 최소 검사 매크로 + 벤치마크 타이머 (외부 의존성 없음)
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+static int host_check_failures;
+
+#define CHECK(cond)                                                                    \
+    do {                                                                               \
+        if (!(cond)) {                                                                 \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond);   \
+            host_check_failures++;                                                     \
+        }                                                                              \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                                                 \
+    do {                                                                               \
+        long long a_ = (long long)(a), b_ = (long long)(b);                            \
+        if (a_ != b_) {                                                                \
+            fprintf(stderr, "%s:%d: %s == %s failed (%lld vs %lld)\n", __FILE__, __LINE__, \
+                    #a, #b, a_, b_);                                                   \
+            host_check_failures++;                                                     \
+        }                                                                              \
+    } while (0)
+
+#define CHECK_NEAR(a, b, eps)                                                          \
+    do {                                                                               \
+        double a_ = (double)(a), b_ = (double)(b);                                     \
+        if (!(fabs(a_ - b_) <= (eps))) {                                               \
+            fprintf(stderr, "%s:%d: %s ~= %s failed (%g vs %g)\n", __FILE__, __LINE__, \
+                    #a, #b, a_, b_);                                                   \
+            host_check_failures++;                                                     \
+        }                                                                              \
+    } while (0)
+
+#define CHECK_STR(a, b)                                                                \
+    do {                                                                               \
+        const char *a_ = (a), *b_ = (b);                                               \
+        if (strcmp(a_, b_) != 0) {                                                     \
+            fprintf(stderr, "%s:%d: %s == \"%s\" failed (got \"%s\")\n", __FILE__, __LINE__, \
+                    #a, b_, a_);                                                       \
+            host_check_failures++;                                                     \
+        }                                                                              \
+    } while (0)
+
+static inline int host_check_result(const char *name)
+{
+    if (host_check_failures) {
+        fprintf(stderr, "%s: %d check(s) failed\n", name, host_check_failures);
+        return 1;
+    }
+    printf("%s: ok\n", name);
+    return 0;
+}
+
+// fn()을 iters번 돌린 평균 ns (최적화로 사라지지 않게 결과는 호출자가 sink에 모음)
+template <typename F>
+static double host_bench_ns(long iters, F fn)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    for (long i = 0; i < iters; i++) fn(i);
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / (double)iters;
+}
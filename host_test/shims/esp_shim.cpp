@@ -0,0 +1,84 @@
+// host shim: esp_err / esp_log / esp_timer / heap 정보 / 인증서 번들
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_system.h"
+#include "esp_heap_caps.h"
+#include "esp_crt_bundle.h"
+#include "host_shims.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdlib.h>
+#include <string.h>
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    switch (code) {
+    case ESP_OK: return "ESP_OK";
+    case ESP_FAIL: return "ESP_FAIL";
+    case ESP_ERR_NO_MEM: return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG: return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE: return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_INVALID_SIZE: return "ESP_ERR_INVALID_SIZE";
+    case ESP_ERR_NOT_FOUND: return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_TIMEOUT: return "ESP_ERR_TIMEOUT";
+    case ESP_ERR_INVALID_RESPONSE: return "ESP_ERR_INVALID_RESPONSE";
+    default: return "ESP_ERR_?";
+    }
+}
+
+int host_log_enabled(char level)
+{
+    static const char *const order = "EWIDV";
+    static int max = -1;
+    if (max < 0) {
+        const char *env = getenv("HOST_LOG");
+        const char *p = env && env[0] ? strchr(order, env[0]) : nullptr;
+        max = p ? (int)(p - order) : 1;
+    }
+    const char *p = strchr(order, level);
+    return p && (p - order) <= max;
+}
+
+static std::atomic<bool> s_virtual{ false };
+static std::atomic<int64_t> s_virtual_us{ 0 };
+
+int64_t esp_timer_get_time(void)
+{
+    if (s_virtual) return s_virtual_us;
+    static const auto start = std::chrono::steady_clock::now();
+    // 0은 "아직 없음" 표시로 쓰는 곳이 있어서 1 s부터 시작
+    return 1000000 + std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+void host_timer_set_virtual(int64_t start_us)
+{
+    s_virtual_us = start_us;
+    s_virtual = true;
+}
+
+void host_timer_advance_us(int64_t us)
+{
+    s_virtual_us += us;
+}
+
+static uint32_t s_heap_free = 200 * 1024;
+static uint32_t s_heap_min = 150 * 1024;
+static uint32_t s_heap_largest = 100 * 1024;
+
+void host_heap_set(uint32_t free_bytes, uint32_t min_free, uint32_t largest)
+{
+    s_heap_free = free_bytes;
+    s_heap_min = min_free;
+    s_heap_largest = largest;
+}
+
+uint32_t esp_get_free_heap_size(void) { return s_heap_free; }
+uint32_t esp_get_minimum_free_heap_size(void) { return s_heap_min; }
+size_t heap_caps_get_free_size(unsigned caps) { return s_heap_free; }
+size_t heap_caps_get_minimum_free_size(unsigned caps) { return s_heap_min; }
+size_t heap_caps_get_largest_free_block(unsigned caps) { return s_heap_largest; }
+
+esp_err_t esp_crt_bundle_attach(void *conf) { return ESP_OK; }
@@ -0,0 +1,116 @@
+// host shim: FreeRTOS 태스크 / 세마포어 / critical section
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct host_task {
+    std::string name;
+};
+
+struct host_sem {
+    std::mutex              m;
+    std::condition_variable cv;
+    int                     count;
+};
+
+static std::mutex s_tasks_lock;
+static std::vector<host_task *> s_tasks;
+
+void host_mux_enter(portMUX_TYPE *mux)
+{
+    while (__atomic_exchange_n(&mux->locked, 1, __ATOMIC_ACQUIRE)) std::this_thread::yield();
+}
+
+void host_mux_exit(portMUX_TYPE *mux)
+{
+    __atomic_store_n(&mux->locked, 0, __ATOMIC_RELEASE);
+}
+
+TaskHandle_t xTaskCreateStatic(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *arg,
+                               UBaseType_t prio, StackType_t *stack, StaticTask_t *tcb)
+{
+    host_task *t = new host_task{ name };
+    {
+        std::lock_guard<std::mutex> g(s_tasks_lock);
+        s_tasks.push_back(t);
+    }
+    std::thread(fn, arg).detach();
+    return t;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *arg,
+                       UBaseType_t prio, TaskHandle_t *out)
+{
+    TaskHandle_t t = xTaskCreateStatic(fn, name, stack_depth, arg, prio, nullptr, nullptr);
+    if (out) *out = t;
+    return pdPASS;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    static const auto start = std::chrono::steady_clock::now();
+    return (TickType_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+TaskHandle_t xTaskGetHandle(const char *name)
+{
+    std::lock_guard<std::mutex> g(s_tasks_lock);
+    for (host_task *t : s_tasks) {
+        if (t->name == name) return t;
+    }
+    return nullptr;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task)
+{
+    return 0;  // host thread stack은 측정하지 않음
+}
+
+static SemaphoreHandle_t sem_new(int count)
+{
+    host_sem *s = new host_sem;
+    s->count = count;
+    return s;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void) { return sem_new(0); }
+SemaphoreHandle_t xSemaphoreCreateMutex(void) { return sem_new(1); }
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t *mem) { return sem_new(0); }
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t *mem) { return sem_new(1); }
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks)
+{
+    std::unique_lock<std::mutex> g(sem->m);
+    auto ready = [sem] { return sem->count > 0; };
+    if (ticks == portMAX_DELAY) {
+        sem->cv.wait(g, ready);
+    } else if (!sem->cv.wait_for(g, std::chrono::milliseconds(ticks), ready)) {
+        return pdFALSE;
+    }
+    sem->count--;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    {
+        std::lock_guard<std::mutex> g(sem->m);
+        if (sem->count > 0) return pdFALSE;  // binary / mutex: 이미 있음
+        sem->count = 1;
+    }
+    sem->cv.notify_one();
+    return pdTRUE;
+}
@@ -0,0 +1,180 @@
+// host shim: 가짜 esp_http_client. 요청을 기록하고 정해둔 결과를 돌려줌 (연결 재사용 여부를 셈)
+#include "esp_http_client.h"
+#include "host_shims.h"
+#include "esp_timer.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct esp_http_client {
+    esp_http_client_config_t cfg;
+    std::string url;
+    std::string host_header;
+    std::string body;
+    bool        connected;
+    int         status;
+};
+
+struct result_t {
+    esp_err_t err;
+    int       status;
+};
+
+static std::mutex s_lock;
+static std::condition_variable s_cv;
+static std::deque<result_t> s_results;
+static std::vector<host_http_req_t> s_requests;
+static host_http_stats_t s_stats;
+static std::string s_response;
+static int s_latency_ms;
+
+void host_http_push_result(esp_err_t err, int status)
+{
+    std::lock_guard<std::mutex> g(s_lock);
+    s_results.push_back({ err, status });
+}
+
+void host_http_set_latency_ms(int ms)
+{
+    std::lock_guard<std::mutex> g(s_lock);
+    s_latency_ms = ms;
+}
+
+void host_http_set_response(const char *body)
+{
+    std::lock_guard<std::mutex> g(s_lock);
+    s_response = body ? body : "";
+}
+
+void host_http_get_stats(host_http_stats_t *out)
+{
+    std::lock_guard<std::mutex> g(s_lock);
+    *out = s_stats;
+}
+
+int host_http_request_count(void)
+{
+    std::lock_guard<std::mutex> g(s_lock);
+    return (int)s_requests.size();
+}
+
+int host_http_get_request(int i, host_http_req_t *out)
+{
+    std::lock_guard<std::mutex> g(s_lock);
+    if (i < 0 || i >= (int)s_requests.size()) return 0;
+    *out = s_requests[i];
+    return 1;
+}
+
+int host_http_wait_requests(int n, int timeout_ms)
+{
+    std::unique_lock<std::mutex> g(s_lock);
+    return s_cv.wait_for(g, std::chrono::milliseconds(timeout_ms), [n] { return (int)s_requests.size() >= n; });
+}
+
+esp_http_client_handle_t esp_http_client_init(const esp_http_client_config_t *config)
+{
+    esp_http_client *c = new esp_http_client{};
+    c->cfg = *config;
+    c->url = config->url ? config->url : "";
+    std::lock_guard<std::mutex> g(s_lock);
+    s_stats.inits++;
+    return c;
+}
+
+esp_err_t esp_http_client_perform(esp_http_client_handle_t c)
+{
+    result_t r = { ESP_OK, 200 };
+    int latency;
+    std::string response;
+    {
+        std::lock_guard<std::mutex> g(s_lock);
+        if (!s_results.empty()) {
+            r = s_results.front();
+            s_results.pop_front();
+        }
+        latency = s_latency_ms;
+        response = s_response;
+        s_stats.performs++;
+        if (!c->connected) s_stats.connects++;
+    }
+    int64_t t0 = esp_timer_get_time();
+    if (latency) std::this_thread::sleep_for(std::chrono::milliseconds(latency));
+
+    if (r.err != ESP_OK) {
+        c->connected = false;
+        return r.err;
+    }
+    c->connected = true;
+    c->status = r.status;
+
+    if (c->cfg.event_handler && !response.empty()) {
+        esp_http_client_event_t evt = {};
+        evt.event_id = HTTP_EVENT_ON_DATA;
+        evt.client = c;
+        evt.data = (void *)response.data();
+        evt.data_len = (int)response.size();
+        evt.user_data = c->cfg.user_data;
+        c->cfg.event_handler(&evt);
+    }
+
+    {
+        std::lock_guard<std::mutex> g(s_lock);
+        host_http_req_t req = {};
+        snprintf(req.url, sizeof(req.url), "%s", c->url.c_str());
+        snprintf(req.host_header, sizeof(req.host_header), "%s", c->host_header.c_str());
+        req.body_len = (int)c->body.size();
+        memcpy(req.body, c->body.data(), c->body.size() < sizeof(req.body) - 1 ? c->body.size() : sizeof(req.body) - 1);
+        req.at_us = t0;
+        if (s_requests.size() < 256) s_requests.push_back(req);
+    }
+    s_cv.notify_all();
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_set_url(esp_http_client_handle_t c, const char *url)
+{
+    c->url = url;
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_set_header(esp_http_client_handle_t c, const char *key, const char *value)
+{
+    if (strcmp(key, "Host") == 0) c->host_header = value;
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_set_post_field(esp_http_client_handle_t c, const char *data, int len)
+{
+    c->body.assign(data, len);
+    return ESP_OK;
+}
+
+int esp_http_client_get_status_code(esp_http_client_handle_t c)
+{
+    return c->status;
+}
+
+esp_err_t esp_http_client_close(esp_http_client_handle_t c)
+{
+    c->connected = false;
+    std::lock_guard<std::mutex> g(s_lock);
+    s_stats.closes++;
+    return ESP_OK;
+}
+
+esp_err_t esp_http_client_cleanup(esp_http_client_handle_t c)
+{
+    {
+        std::lock_guard<std::mutex> g(s_lock);
+        s_stats.cleanups++;
+    }
+    delete c;
+    return ESP_OK;
+}
@@ -0,0 +1,10 @@
+#pragma once
+// host shim
+
+typedef enum {
+    GPIO_NUM_NC = -1,
+    GPIO_NUM_4 = 4,
+    GPIO_NUM_18 = 18,
+    GPIO_NUM_34 = 34,
+    GPIO_NUM_35 = 35,
+} gpio_num_t;
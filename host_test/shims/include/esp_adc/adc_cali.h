@@ -0,0 +1,17 @@
+#pragma once
+// host shim: ADC 보정 드라이버 (ESP32 line fitting 경로를 흉내낸 모델, adc_cali_shim.cpp)
+
+#include "esp_err.h"
+#include "hal/adc_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct adc_cali_scheme_t *adc_cali_handle_t;
+
+esp_err_t adc_cali_raw_to_voltage(adc_cali_handle_t handle, int raw, int *voltage);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,14 @@
+#pragma once
+// host shim: 인증서 번들은 가짜 HTTP client에서 쓰지 않음
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+esp_err_t esp_crt_bundle_attach(void *conf);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,18 @@
+#pragma once
+// host shim
+
+#include <stddef.h>
+
+#define MALLOC_CAP_8BIT (1 << 2)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+size_t heap_caps_get_free_size(unsigned caps);
+size_t heap_caps_get_minimum_free_size(unsigned caps);
+size_t heap_caps_get_largest_free_block(unsigned caps);
+
+#ifdef __cplusplus
+}
+#endif
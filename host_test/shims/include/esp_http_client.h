@@ -0,0 +1,106 @@
+#pragma once
+// host shim: 가짜 esp_http_client. 네트워크 없이 요청을 기록하고 host_http_*()로 정한 결과를 돌려줌
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#define ESP_ERR_HTTP_BASE        0x7000
+#define ESP_ERR_HTTP_CONNECT     (ESP_ERR_HTTP_BASE + 3)
+#define ESP_ERR_HTTP_EAGAIN      (ESP_ERR_HTTP_BASE + 7)
+
+typedef struct esp_http_client *esp_http_client_handle_t;
+
+typedef enum {
+    HTTP_EVENT_ERROR = 0,
+    HTTP_EVENT_ON_CONNECTED,
+    HTTP_EVENT_HEADERS_SENT,
+    HTTP_EVENT_ON_HEADER,
+    HTTP_EVENT_ON_DATA,
+    HTTP_EVENT_ON_FINISH,
+    HTTP_EVENT_DISCONNECTED,
+    HTTP_EVENT_REDIRECT,
+} esp_http_client_event_id_t;
+
+typedef struct {
+    esp_http_client_event_id_t event_id;
+    esp_http_client_handle_t   client;
+    void                      *data;
+    int                        data_len;
+    void                      *user_data;
+    char                      *header_key;
+    char                      *header_value;
+} esp_http_client_event_t;
+
+typedef esp_err_t (*http_event_handle_cb)(esp_http_client_event_t *evt);
+
+typedef enum {
+    HTTP_METHOD_GET = 0,
+    HTTP_METHOD_POST,
+    HTTP_METHOD_PUT,
+    HTTP_METHOD_PATCH,
+    HTTP_METHOD_DELETE,
+} esp_http_client_method_t;
+
+typedef enum {
+    HTTP_AUTH_TYPE_NONE = 0,
+} esp_http_client_auth_type_t;
+
+// 필드 순서는 ESP-IDF와 같음 (designated initializer 순서 검사)
+typedef struct {
+    const char                 *url;
+    const char                 *host;
+    int                         port;
+    const char                 *username;
+    const char                 *password;
+    esp_http_client_auth_type_t auth_type;
+    const char                 *path;
+    const char                 *query;
+    const char                 *cert_pem;
+    size_t                      cert_len;
+    const char                 *client_cert_pem;
+    size_t                      client_cert_len;
+    const char                 *client_key_pem;
+    size_t                      client_key_len;
+    const char                 *client_key_password;
+    size_t                      client_key_password_len;
+    const char                 *user_agent;
+    esp_http_client_method_t    method;
+    int                         timeout_ms;
+    bool                        disable_auto_redirect;
+    int                         max_redirection_count;
+    int                         max_authorization_retries;
+    http_event_handle_cb        event_handler;
+    int                         transport_type;
+    int                         buffer_size;
+    int                         buffer_size_tx;
+    void                       *user_data;
+    bool                        is_async;
+    bool                        use_global_ca_store;
+    bool                        skip_cert_common_name_check;
+    const char                 *common_name;
+    esp_err_t                 (*crt_bundle_attach)(void *conf);
+    bool                        keep_alive_enable;
+    int                         keep_alive_idle;
+    int                         keep_alive_interval;
+    int                         keep_alive_count;
+    int                         if_name;
+    bool                        save_client_session;
+} esp_http_client_config_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+esp_http_client_handle_t esp_http_client_init(const esp_http_client_config_t *config);
+esp_err_t esp_http_client_perform(esp_http_client_handle_t client);
+esp_err_t esp_http_client_set_url(esp_http_client_handle_t client, const char *url);
+esp_err_t esp_http_client_set_header(esp_http_client_handle_t client, const char *key, const char *value);
+esp_err_t esp_http_client_set_post_field(esp_http_client_handle_t client, const char *data, int len);
+int esp_http_client_get_status_code(esp_http_client_handle_t client);
+esp_err_t esp_http_client_close(esp_http_client_handle_t client);
+esp_err_t esp_http_client_cleanup(esp_http_client_handle_t client);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,23 @@
+#pragma once
+// host shim: ESP_LOGx -> stderr. 기본은 W 이상만, HOST_LOG=I (또는 D) 환경 변수로 더 자세히
+
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int host_log_enabled(char level);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define HOST_LOG_(lvl, tag, fmt, ...) \
+    do { if (host_log_enabled(lvl)) fprintf(stderr, "%c (%s) " fmt "\n", lvl, tag, ##__VA_ARGS__); } while (0)
+
+#define ESP_LOGE(tag, fmt, ...) HOST_LOG_('E', tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) HOST_LOG_('W', tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) HOST_LOG_('I', tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGD(tag, fmt, ...) HOST_LOG_('D', tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGV(tag, fmt, ...) HOST_LOG_('V', tag, fmt, ##__VA_ARGS__)
@@ -0,0 +1,26 @@
+#pragma once
+// host shim: esp_sntp.h. 호스트 시계는 이미 맞아 있으므로 시작만 기록
+
+#include <stdbool.h>
+#include <sys/time.h>
+
+typedef enum {
+    ESP_SNTP_OPMODE_POLL,
+    ESP_SNTP_OPMODE_LISTENONLY,
+} esp_sntp_operatingmode_t;
+
+typedef void (*sntp_sync_time_cb_t)(struct timeval *tv);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void esp_sntp_setoperatingmode(esp_sntp_operatingmode_t mode);
+void esp_sntp_setservername(unsigned char idx, const char *server);
+void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t cb);
+void esp_sntp_init(void);
+bool esp_sntp_enabled(void);
+
+#ifdef __cplusplus
+}
+#endif
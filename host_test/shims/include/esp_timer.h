@@ -0,0 +1,14 @@
+#pragma once
+// host shim: esp_timer_get_time(). 실제 monotonic 시계, 또는 host_timer_set_virtual()로 가상 시계
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int64_t esp_timer_get_time(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,53 @@
+#pragma once
+// host shim: FreeRTOS 타입 / critical section. 태스크는 pthread, tick은 1 ms
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef uint32_t TickType_t;
+typedef int      BaseType_t;
+typedef unsigned UBaseType_t;
+typedef uint8_t  StackType_t;   // ESP-IDF처럼 stack 깊이는 byte 단위
+
+#define pdTRUE   1
+#define pdFALSE  0
+#define pdPASS   1
+#define pdFAIL   0
+#define portMAX_DELAY      ((TickType_t)0xffffffffu)
+#define portTICK_PERIOD_MS 1
+#define configTICK_RATE_HZ 1000
+#define pdMS_TO_TICKS(ms)  ((TickType_t)(ms))
+
+typedef struct { uint8_t opaque[96]; } StaticTask_t;
+typedef struct { uint8_t opaque[80]; } StaticQueue_t;
+typedef StaticQueue_t StaticSemaphore_t;
+
+typedef struct host_task *TaskHandle_t;
+typedef struct host_sem  *SemaphoreHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+// spinlock (태스크 사이에서만 씀, ISR 없음)
+typedef struct {
+    volatile int locked;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED { 0 }
+#define IRAM_ATTR
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void host_mux_enter(portMUX_TYPE *mux);
+void host_mux_exit(portMUX_TYPE *mux);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define portENTER_CRITICAL(mux)     host_mux_enter(mux)
+#define portEXIT_CRITICAL(mux)      host_mux_exit(mux)
+#define portENTER_CRITICAL_ISR(mux) host_mux_enter(mux)
+#define portEXIT_CRITICAL_ISR(mux)  host_mux_exit(mux)
@@ -0,0 +1,19 @@
+#pragma once
+// host shim: binary / mutex 세마포어 (pthread mutex + condvar). Static 변형도 heap에 만듦
+
+#include "FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t *mem);
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t *mem);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,68 @@
+#pragma once
+// host shim 제어 API (테스트 전용). ESP-IDF에는 없음
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* esp_timer: 가상 시계로 바꾸면 host_timer_advance_us()로만 흐름 */
+void host_timer_set_virtual(int64_t start_us);
+void host_timer_advance_us(int64_t us);
+
+/* time(): 설정하면 그 unix 시각에 멈춘 벽시계 (-1 이면 실제 시계로) */
+void host_time_set(int64_t unix_s);
+
+/* heap 크기 (esp_get_free_heap_size 등이 돌려줄 값) */
+void host_heap_set(uint32_t free_bytes, uint32_t min_free, uint32_t largest);
+
+/* 가짜 HTTP client */
+typedef struct {
+    uint32_t inits;       // esp_http_client_init
+    uint32_t cleanups;
+    uint32_t closes;
+    uint32_t connects;    // init/close 뒤 첫 perform (= TCP/TLS handshake)
+    uint32_t performs;
+} host_http_stats_t;
+
+typedef struct {
+    char     url[160];
+    char     host_header[96];
+    char     body[1024];
+    int      body_len;
+    int64_t  at_us;       // perform 시작 시각
+} host_http_req_t;
+
+// 다음 perform 결과를 차례로 (없으면 ESP_OK / 200)
+void host_http_push_result(esp_err_t err, int status);
+// perform 한 번에 걸리는 시간 (실제 sleep)
+void host_http_set_latency_ms(int ms);
+// 응답 body (HTTP_EVENT_ON_DATA로 전달)
+void host_http_set_response(const char *body);
+void host_http_get_stats(host_http_stats_t *out);
+// 기록된 요청 수 / i번째 요청 복사 (최대 256개 보관)
+int host_http_request_count(void);
+int host_http_get_request(int i, host_http_req_t *out);
+// 조건을 만족하는 요청이 n개가 될 때까지 기다림 (timeout이면 false)
+int host_http_wait_requests(int n, int timeout_ms);
+
+/* 가짜 resolver */
+void host_dns_set(const char *host, const char *ip);   // ip NULL이면 조회 실패
+uint32_t host_dns_lookups(void);
+
+/* 파일 기반 파티션 (path가 없으면 0xFF로 채워서 만듦) */
+const void *host_partition_register(const char *label, const char *path, uint32_t size, uint32_t erase_size);
+// 다음 write를 len byte만 쓰고 실패시킴 (전원 차단 흉내), -1이면 해제
+void host_partition_fail_write_after(int32_t bytes);
+
+/* 센서 경로: ADC 엔진 / DHT 드라이버 대신 정해둔 값
+ * ADC raw -> mV 테이블은 선형 (0..4095 -> 0..3300 mV) */
+void host_adc_set_raw(int channel, float raw);   // raw < 0 이면 읽기 실패
+void host_dht_set(esp_err_t err, int16_t humidity_x10, int16_t temperature_x10);
+
+#ifdef __cplusplus
+}
+#endif
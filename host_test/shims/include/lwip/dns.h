@@ -0,0 +1,15 @@
+#pragma once
+// host shim
+
+#include <stdint.h>
+#include "ip_addr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void dns_setserver(uint8_t numdns, const ip_addr_t *dnsserver);
+
+#ifdef __cplusplus
+}
+#endif
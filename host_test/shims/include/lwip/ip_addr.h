@@ -0,0 +1,18 @@
+#pragma once
+// host shim
+
+#include <stdint.h>
+
+typedef struct {
+    uint32_t addr;
+} ip_addr_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int ipaddr_aton(const char *cp, ip_addr_t *addr);
+
+#ifdef __cplusplus
+}
+#endif
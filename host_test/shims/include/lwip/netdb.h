@@ -0,0 +1,26 @@
+#pragma once
+// host shim: 가짜 resolver (host_dns_set()으로 정한 주소, 조회 횟수를 셈)
+
+#include "sockets.h"
+
+struct addrinfo {
+    int              ai_flags;
+    int              ai_family;
+    int              ai_socktype;
+    int              ai_protocol;
+    socklen_t        ai_addrlen;
+    struct sockaddr *ai_addr;
+    char            *ai_canonname;
+    struct addrinfo *ai_next;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int getaddrinfo(const char *node, const char *service, const struct addrinfo *hints, struct addrinfo **res);
+void freeaddrinfo(struct addrinfo *ai);
+
+#ifdef __cplusplus
+}
+#endif
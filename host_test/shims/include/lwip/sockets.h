@@ -0,0 +1,38 @@
+#pragma once
+// host shim
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint32_t socklen_t;
+
+#define AF_INET     2
+#define SOCK_STREAM 1
+
+struct in_addr {
+    uint32_t s_addr;
+};
+
+struct sockaddr {
+    uint8_t  sa_len;
+    uint8_t  sa_family;
+    char     sa_data[14];
+};
+
+struct sockaddr_in {
+    uint8_t        sin_len;
+    uint8_t        sin_family;
+    uint16_t       sin_port;
+    struct in_addr sin_addr;
+    char           sin_zero[8];
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+char *inet_ntoa_r(struct in_addr addr, char *buf, int buflen);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,17 @@
+#pragma once
+// host build 설정: Kconfig.projbuild 기본값과 같고, 테스트가 빨리 끝나도록 batch window만 짧게
+
+#define CONFIG_DHT_CAPTURE_EDGE_ISR      1
+#define CONFIG_SENSOR_MAINS_FREQ_HZ      60
+#define CONFIG_SNTP_SERVER               "pool.ntp.org"
+
+#define CONFIG_FB_BATCH_WINDOW_MS        50
+#define CONFIG_FB_BATCH_MAX_KEYS         8
+#define CONFIG_FB_ENCODING_JSON          1
+#define CONFIG_FB_DNS_CACHE_TTL_S        300
+#define CONFIG_FB_DIAGNOSTICS_INTERVAL_S 900
+#define CONFIG_FB_HEALTH_INTERVAL_S      1800
+#define CONFIG_FB_OFFLINE_LOG            1
+#define CONFIG_FB_OFFLINE_PARTITION      "fb_log"
+#define CONFIG_FB_REPLAY_BATCH           32
+#define CONFIG_FB_REPLAY_INTERVAL_MS     2000
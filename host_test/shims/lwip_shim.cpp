@@ -0,0 +1,80 @@
+// host shim: 가짜 resolver + lwip DNS 설정
+#include "lwip/netdb.h"
+#include "lwip/dns.h"
+#include "host_shims.h"
+
+#include <atomic>
+#include <mutex>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+static std::mutex s_lock;
+static std::string s_host;
+static std::string s_ip;
+static std::atomic<uint32_t> s_lookups{ 0 };
+
+void host_dns_set(const char *host, const char *ip)
+{
+    std::lock_guard<std::mutex> g(s_lock);
+    s_host = host;
+    s_ip = ip ? ip : "";
+}
+
+uint32_t host_dns_lookups(void)
+{
+    return s_lookups;
+}
+
+static uint32_t parse_ipv4(const char *s)
+{
+    unsigned a = 0, b = 0, c = 0, d = 0;
+    sscanf(s, "%u.%u.%u.%u", &a, &b, &c, &d);
+    uint8_t bytes[4] = { (uint8_t)a, (uint8_t)b, (uint8_t)c, (uint8_t)d };
+    uint32_t v;
+    memcpy(&v, bytes, 4);  // network order
+    return v;
+}
+
+struct host_ai {
+    struct addrinfo    ai;
+    struct sockaddr_in sin;
+};
+
+int getaddrinfo(const char *node, const char *service, const struct addrinfo *hints, struct addrinfo **res)
+{
+    s_lookups++;
+    std::lock_guard<std::mutex> g(s_lock);
+    if (s_ip.empty() || s_host != node) return -1;
+
+    host_ai *h = new host_ai{};
+    h->sin.sin_family = AF_INET;
+    h->sin.sin_addr.s_addr = parse_ipv4(s_ip.c_str());
+    h->ai.ai_family = AF_INET;
+    h->ai.ai_addr = (struct sockaddr *)&h->sin;
+    h->ai.ai_addrlen = sizeof(h->sin);
+    *res = &h->ai;
+    return 0;
+}
+
+void freeaddrinfo(struct addrinfo *ai)
+{
+    delete (host_ai *)ai;
+}
+
+char *inet_ntoa_r(struct in_addr addr, char *buf, int buflen)
+{
+    const uint8_t *b = (const uint8_t *)&addr.s_addr;
+    snprintf(buf, buflen, "%u.%u.%u.%u", b[0], b[1], b[2], b[3]);
+    return buf;
+}
+
+int ipaddr_aton(const char *cp, ip_addr_t *addr)
+{
+    addr->addr = parse_ipv4(cp);
+    return 1;
+}
+
+void dns_setserver(uint8_t numdns, const ip_addr_t *dnsserver)
+{
+}
@@ -0,0 +1,71 @@
+// host shim: NVS (namespace/key -> u32, 프로세스 메모리) + SNTP (호출만 기록) + 가짜 벽시계
+#include "nvs.h"
+#include "esp_sntp.h"
+#include "host_shims.h"
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <time.h>
+#include <vector>
+
+static std::vector<std::string> s_namespaces;
+static std::map<std::string, uint32_t> s_u32;
+
+static std::string nvs_key(nvs_handle_t h, const char *key)
+{
+    return s_namespaces[h - 1] + "/" + key;
+}
+
+esp_err_t nvs_open(const char *name, nvs_open_mode_t mode, nvs_handle_t *out)
+{
+    s_namespaces.push_back(name);
+    *out = (nvs_handle_t)s_namespaces.size();
+    return ESP_OK;
+}
+
+esp_err_t nvs_get_u32(nvs_handle_t h, const char *key, uint32_t *out)
+{
+    auto it = s_u32.find(nvs_key(h, key));
+    if (it == s_u32.end()) return ESP_ERR_NVS_NOT_FOUND;
+    *out = it->second;
+    return ESP_OK;
+}
+
+esp_err_t nvs_set_u32(nvs_handle_t h, const char *key, uint32_t value)
+{
+    s_u32[nvs_key(h, key)] = value;
+    return ESP_OK;
+}
+
+esp_err_t nvs_commit(nvs_handle_t h) { return ESP_OK; }
+void nvs_close(nvs_handle_t h) {}
+
+static bool s_sntp;
+
+void esp_sntp_setoperatingmode(esp_sntp_operatingmode_t mode) {}
+void esp_sntp_setservername(unsigned char idx, const char *server) {}
+void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t cb) {}
+void esp_sntp_init(void) { s_sntp = true; }
+bool esp_sntp_enabled(void) { return s_sntp; }
+
+/* time(): host_time_set() 뒤로는 그 값에 멈춘 벽시계 (SNTP 로 맞춘 시계 흉내), 아니면 실제 시계.
+ * 실행 파일에 정의하면 libc 의 time() 대신 쓰임 */
+static std::atomic<int64_t> s_fake_time{ -1 };
+
+void host_time_set(int64_t unix_s)
+{
+    s_fake_time = unix_s;
+}
+
+extern "C" time_t time(time_t *out) noexcept
+{
+    int64_t t = s_fake_time;
+    if (t < 0) {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        t = ts.tv_sec;
+    }
+    if (out) *out = (time_t)t;
+    return (time_t)t;
+}
@@ -0,0 +1,120 @@
+// host shim: 파일 기반 가짜 flash 파티션 (NOR처럼 write는 bit 1->0만)
+#include "esp_partition.h"
+#include "host_shims.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+struct host_part {
+    esp_partition_t part;
+    std::string     path;
+};
+
+static std::vector<host_part *> s_parts;
+static int32_t s_fail_after = -1;
+
+static FILE *open_part(const host_part *p)
+{
+    return fopen(p->path.c_str(), "r+b");
+}
+
+const void *host_partition_register(const char *label, const char *path, uint32_t size, uint32_t erase_size)
+{
+    host_part *p = new host_part{};
+    p->part.type = ESP_PARTITION_TYPE_DATA;
+    p->part.subtype = ESP_PARTITION_SUBTYPE_ANY;
+    p->part.size = size;
+    p->part.erase_size = erase_size;
+    snprintf(p->part.label, sizeof(p->part.label), "%s", label);
+    p->path = path;
+
+    FILE *f = fopen(path, "rb");
+    if (f) {
+        fclose(f);
+    } else {
+        f = fopen(path, "wb");
+        std::vector<uint8_t> ff(size, 0xFF);
+        fwrite(ff.data(), 1, size, f);
+        fclose(f);
+    }
+    s_parts.push_back(p);
+    return &p->part;
+}
+
+void host_partition_fail_write_after(int32_t bytes)
+{
+    s_fail_after = bytes;
+}
+
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char *label)
+{
+    for (host_part *p : s_parts) {
+        if (strcmp(p->part.label, label) == 0) return &p->part;
+    }
+    return nullptr;
+}
+
+static const host_part *find(const esp_partition_t *part)
+{
+    for (host_part *p : s_parts) {
+        if (&p->part == part) return p;
+    }
+    return nullptr;
+}
+
+esp_err_t esp_partition_read(const esp_partition_t *part, size_t offset, void *dst, size_t size)
+{
+    const host_part *p = find(part);
+    if (!p || offset + size > part->size) return ESP_ERR_INVALID_ARG;
+    FILE *f = open_part(p);
+    fseek(f, (long)offset, SEEK_SET);
+    size_t n = fread(dst, 1, size, f);
+    fclose(f);
+    return n == size ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t esp_partition_write(const esp_partition_t *part, size_t offset, const void *src, size_t size)
+{
+    const host_part *p = find(part);
+    if (!p || offset + size > part->size) return ESP_ERR_INVALID_ARG;
+
+    size_t n = size;
+    bool fail = false;
+    if (s_fail_after >= 0) {
+        if ((size_t)s_fail_after < n) {
+            n = (size_t)s_fail_after;
+            fail = true;
+        }
+        s_fail_after = -1;
+    }
+
+    std::vector<uint8_t> cur(n);
+    FILE *f = open_part(p);
+    fseek(f, (long)offset, SEEK_SET);
+    if (fread(cur.data(), 1, n, f) != n) {
+        fclose(f);
+        return ESP_FAIL;
+    }
+    for (size_t i = 0; i < n; i++) cur[i] &= ((const uint8_t *)src)[i];
+    fseek(f, (long)offset, SEEK_SET);
+    fwrite(cur.data(), 1, n, f);
+    fclose(f);
+    return fail ? ESP_FAIL : ESP_OK;
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t *part, size_t offset, size_t size)
+{
+    const host_part *p = find(part);
+    if (!p || offset % part->erase_size || size % part->erase_size || offset + size > part->size) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    std::vector<uint8_t> ff(size, 0xFF);
+    FILE *f = open_part(p);
+    fseek(f, (long)offset, SEEK_SET);
+    fwrite(ff.data(), 1, size, f);
+    fclose(f);
+    return ESP_OK;
+}
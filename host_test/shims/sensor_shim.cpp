@@ -0,0 +1,57 @@
+// host shim: ADC 엔진과 DHT 드라이버 (센서 태스크의 변환 로직만 host에서 돌림)
+#include "adc_shared.h"
+#include "adc_ring.h"
+#include "drivers/dht.h"
+#include "host_shims.h"
+
+static uint16_t s_lut[ADC_RAW_MAX + 1];
+uint16_t *adc_mv_lut[ADC_ATTEN_COUNT];
+
+static float s_raw[ADC_RING_MAX_CH];
+static bool s_raw_ok[ADC_RING_MAX_CH];
+
+static esp_err_t s_dht_err = ESP_FAIL;
+static int16_t s_dht_humi;
+static int16_t s_dht_temp;
+
+void init_shared_adc()
+{
+    for (int raw = 0; raw <= ADC_RAW_MAX; raw++) s_lut[raw] = (uint16_t)(raw * 3300 / ADC_RAW_MAX);
+    adc_mv_lut[ADC_SENSOR_ATTEN] = s_lut;
+}
+
+void host_adc_set_raw(int channel, float raw)
+{
+    if (!adc_mv_lut[ADC_SENSOR_ATTEN]) init_shared_adc();
+    s_raw[channel] = raw;
+    s_raw_ok[channel] = raw >= 0;
+}
+
+esp_err_t adc_engine_read(adc_channel_t channel, int samples, float *raw)
+{
+    if (channel < 0 || channel >= ADC_RING_MAX_CH || !s_raw_ok[channel]) return ESP_ERR_INVALID_STATE;
+    *raw = s_raw[channel];
+    return ESP_OK;
+}
+
+esp_err_t adc_engine_read_filtered(adc_channel_t channel, const sensor_filter_cfg_t *cfg,
+                                   sensor_filter_t *state, float *raw, int64_t *busy_us)
+{
+    if (busy_us) *busy_us = 0;
+    return adc_engine_read(channel, 1, raw);
+}
+
+void host_dht_set(esp_err_t err, int16_t humidity_x10, int16_t temperature_x10)
+{
+    s_dht_err = err;
+    s_dht_humi = humidity_x10;
+    s_dht_temp = temperature_x10;
+}
+
+esp_err_t dht_read_data(dht_sensor_type_t sensor_type, gpio_num_t pin, int16_t *humidity, int16_t *temperature)
+{
+    if (s_dht_err != ESP_OK) return s_dht_err;
+    if (humidity) *humidity = s_dht_humi;
+    if (temperature) *temperature = s_dht_temp;
+    return ESP_OK;
+}
@@ -0,0 +1,43 @@
+#include "adc_ring.h"
+
+int adc_ring_average(const adc_ring_t *ring, int n, float *avg)
+{
+    if (n > ring->count) n = ring->count;
+    if (n <= 0) return 0;
+
+    uint32_t sum = 0;
+    int idx = (ring->head + ADC_RING_LEN - n) % ADC_RING_LEN;
+    for (int i = 0; i < n; i++) {
+        sum += ring->samples[idx];
+        idx = (idx + 1) % ADC_RING_LEN;
+    }
+    *avg = (float)sum / n;
+    return n;
+}
+
+int adc_ring_copy_latest(const adc_ring_t *ring, int n, uint16_t *out)
+{
+    if (n > ring->count) n = ring->count;
+    if (n <= 0) return 0;
+
+    int idx = (ring->head + ADC_RING_LEN - n) % ADC_RING_LEN;
+    for (int i = 0; i < n; i++) {
+        out[i] = ring->samples[idx];
+        idx = (idx + 1) % ADC_RING_LEN;
+    }
+    return n;
+}
+
+size_t adc_demux_type1(const uint8_t *frame, size_t len,
+                       adc_ring_t *rings, const int8_t ring_of_channel[ADC_RING_MAX_CH])
+{
+    size_t used = 0;
+    for (size_t i = 0; i + 1 < len; i += 2) {
+        uint16_t word = (uint16_t)(frame[i] | (frame[i + 1] << 8));
+        int8_t r = ring_of_channel[word >> 12];
+        if (r < 0) continue;
+        adc_ring_push(&rings[r], word & 0x0FFF);
+        used++;
+    }
+    return used;
+}
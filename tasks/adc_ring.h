@@ -0,0 +1,44 @@
+#pragma once
+
+// ADC 연속(DMA) 모드 프레임 -> 채널별 ring buffer.
+// ESP-IDF 의존성이 없는 순수 코드 (합성 DMA 프레임으로 host에서 검증 가능)
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ADC_RING_LEN        256  // 채널당 보관 샘플 수 (10 kHz/ch 에서 25.6 ms, 50/60 Hz 한 주기 이상)
+#define ADC_RING_MAX_CH     16   // TYPE1 포맷의 channel 필드는 4 bit
+
+typedef struct {
+    uint16_t samples[ADC_RING_LEN];
+    uint16_t head;   // 다음에 쓸 위치
+    uint16_t count;  // 유효 샘플 수 (최대 ADC_RING_LEN)
+    uint32_t total;  // 지금까지 들어온 샘플 수
+} adc_ring_t;
+
+static inline void adc_ring_push(adc_ring_t *ring, uint16_t sample)
+{
+    ring->samples[ring->head] = sample;
+    ring->head = (ring->head + 1) % ADC_RING_LEN;
+    if (ring->count < ADC_RING_LEN) ring->count++;
+    ring->total++;
+}
+
+// 가장 최근 n개 샘플 평균. 실제로 사용한 샘플 수를 반환 (0이면 avg 그대로)
+int adc_ring_average(const adc_ring_t *ring, int n, float *avg);
+
+// 가장 최근 n개 샘플을 오래된 것부터 out에 복사. 복사한 수 반환
+int adc_ring_copy_latest(const adc_ring_t *ring, int n, uint16_t *out);
+
+// ESP32 TYPE1 출력 (2 byte: data[11:0], channel[15:12]) 프레임을 채널별 ring으로 분배.
+// ring_of_channel[ch] 는 rings 인덱스, 음수면 버림. 분배한 샘플 수 반환
+size_t adc_demux_type1(const uint8_t *frame, size_t len,
+                       adc_ring_t *rings, const int8_t ring_of_channel[ADC_RING_MAX_CH]);
+
+#ifdef __cplusplus
+}
+#endif
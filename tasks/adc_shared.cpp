@@ -1,12 +1,171 @@
 #include "adc_shared.h"
-#include <esp_adc/adc_oneshot.h>
+#include "adc_ring.h"
+#include "app_memory_config.h"
+#include <esp_adc/adc_continuous.h>
+#include <esp_adc/adc_cali.h>
+#include <esp_adc/adc_cali_scheme.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+#include "sdkconfig.h"
 
-adc_oneshot_unit_handle_t adc_handle;
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
 
-void init_shared_adc() {
-    adc_oneshot_unit_init_cfg_t unit_cfg = {
+static const char *TAG = "adc_engine";
+
+#define ADC_SAMPLE_FREQ_HZ    20000  // 전체 변환 속도 (ESP32 연속 모드 최소값), 채널 수로 나눠 씀
+#define ADC_FRAME_SIZE        APP_ADC_FRAME_SIZE  // 2 byte/sample -> 20 kHz에서 6.4 ms마다 한 프레임
+#define ADC_POOL_SIZE         (ADC_FRAME_SIZE * 4)
+#define ADC_FRAME_WAIT_MS     20     // 프레임 하나를 기다리는 최대 시간
+
+// 샘플링할 채널 목록. 새 프로브는 여기에 추가
+static const adc_channel_t s_channels[] = {
+    ADC_CHANNEL_6,  // GPIO34, CDS
+    ADC_CHANNEL_7,  // GPIO35, soil moisture
+};
+#define ADC_NUM_CHANNELS (sizeof(s_channels) / sizeof(s_channels[0]))
+static_assert(ADC_NUM_CHANNELS <= ADC_ENGINE_MAX_CHANNELS, "raise ADC_ENGINE_MAX_CHANNELS (adc_shared.h)");
+
+// 채널당 mains 한 주기 동안의 샘플 수 (flicker 성분이 평균에서 상쇄됨)
+#define ADC_BURST_SAMPLES \
+    ((ADC_SAMPLE_FREQ_HZ / ADC_NUM_CHANNELS / CONFIG_SENSOR_MAINS_FREQ_HZ) < ADC_RING_LEN ? \
+     (ADC_SAMPLE_FREQ_HZ / ADC_NUM_CHANNELS / CONFIG_SENSOR_MAINS_FREQ_HZ) : ADC_RING_LEN)
+
+uint16_t *adc_mv_lut[ADC_ATTEN_COUNT];
+
+static adc_continuous_handle_t s_handle;
+static adc_ring_t s_rings[ADC_NUM_CHANNELS];
+static int8_t s_ring_of_channel[ADC_RING_MAX_CH];
+static SemaphoreHandle_t s_lock;  // 엔진 start..stop 구간과 ring은 한 번에 한 호출자만
+static StaticSemaphore_t s_lock_mem;
+static uint8_t s_frame[ADC_FRAME_SIZE];
+static uint16_t s_lut_mem[APP_ADC_LUT_COUNT][ADC_RAW_MAX + 1];  // raw -> mV 테이블 영역 (감쇠 APP_ADC_LUT_COUNT개분)
+static int s_lut_used;
+
+/* 엔진을 켜고 ring 하나에 새 샘플이 samples개 들어올 때까지 DMA 프레임을 나눠 담은 뒤 끔.
+ * 엔진은 burst 동안만 (채널당 mains 한 주기, 약 17~20 ms) 돌고 따로 깨어나는 태스크가 없음. s_lock 잡고 호출 */
+static esp_err_t adc_engine_burst(int ring, int samples)
+{
+    uint32_t len = 0;
+    esp_err_t err = adc_continuous_start(s_handle);
+    if (err != ESP_OK) return err;
+
+    // 지난 burst를 멈출 때 pool에 남은 프레임은 바로 나오므로 버림 (새 프레임은 6.4 ms 뒤부터)
+    while (adc_continuous_read(s_handle, s_frame, sizeof(s_frame), &len, 0) == ESP_OK) {
+    }
+
+    uint32_t want = s_rings[ring].total + (uint32_t)samples;
+    while ((int32_t)(s_rings[ring].total - want) < 0) {
+        err = adc_continuous_read(s_handle, s_frame, sizeof(s_frame), &len, ADC_FRAME_WAIT_MS);
+        if (err != ESP_OK) {
+            ESP_LOGW(TAG, "read failed: %s", esp_err_to_name(err));
+            break;
+        }
+        adc_demux_type1(s_frame, len, s_rings, s_ring_of_channel);
+    }
+
+    adc_continuous_stop(s_handle);
+    return err;
+}
+
+/* 감쇠 하나에 대한 raw -> mV 테이블 생성 (보정 handle은 만들고 바로 지움) */
+static void adc_cali_build_lut(adc_atten_t atten)
+{
+    if (adc_mv_lut[atten]) return;
+    ESP_ERROR_CHECK(s_lut_used < APP_ADC_LUT_COUNT ? ESP_OK : ESP_ERR_NO_MEM);
+    uint16_t *lut = s_lut_mem[s_lut_used++];
+
+    adc_cali_handle_t cali_handle;
+    adc_cali_line_fitting_config_t cali_cfg = {
         .unit_id = ADC_UNIT_1,
-        .ulp_mode = ADC_ULP_MODE_DISABLE,
+        .atten = atten,
+        .bitwidth = ADC_BITWIDTH_12,
+    };
+    ESP_ERROR_CHECK(adc_cali_create_scheme_line_fitting(&cali_cfg, &cali_handle));
+    for (int raw = 0; raw <= ADC_RAW_MAX; raw++) {
+        int mv = 0;
+        ESP_ERROR_CHECK(adc_cali_raw_to_voltage(cali_handle, raw, &mv));
+        lut[raw] = (uint16_t)mv;
+    }
+    adc_cali_delete_scheme_line_fitting(cali_handle);
+
+    adc_mv_lut[atten] = lut;
+    ESP_LOGI(TAG, "cali lut atten=%d: 0 -> %d mV, %d -> %d mV", atten, lut[0], ADC_RAW_MAX, lut[ADC_RAW_MAX]);
+}
+
+void init_shared_adc() {
+    adc_cali_build_lut(ADC_SENSOR_ATTEN);
+
+    adc_continuous_handle_cfg_t handle_cfg = {
+        .max_store_buf_size = ADC_POOL_SIZE,
+        .conv_frame_size = ADC_FRAME_SIZE,
+    };
+    ESP_ERROR_CHECK(adc_continuous_new_handle(&handle_cfg, &s_handle));
+
+    adc_digi_pattern_config_t pattern[ADC_NUM_CHANNELS] = {};
+    for (int i = 0; i < ADC_RING_MAX_CH; i++) s_ring_of_channel[i] = -1;
+    for (int i = 0; i < (int)ADC_NUM_CHANNELS; i++) {
+        pattern[i].atten = ADC_SENSOR_ATTEN;
+        pattern[i].channel = s_channels[i];
+        pattern[i].unit = ADC_UNIT_1;
+        pattern[i].bit_width = ADC_BITWIDTH_12;
+        s_ring_of_channel[s_channels[i]] = i;
+    }
+
+    adc_continuous_config_t dig_cfg = {
+        .pattern_num = ADC_NUM_CHANNELS,
+        .adc_pattern = pattern,
+        .sample_freq_hz = ADC_SAMPLE_FREQ_HZ,
+        .conv_mode = ADC_CONV_SINGLE_UNIT_1,
+        .format = ADC_DIGI_OUTPUT_FORMAT_TYPE1,
     };
-    ESP_ERROR_CHECK(adc_oneshot_new_unit(&unit_cfg, &adc_handle));
+    ESP_ERROR_CHECK(adc_continuous_config(s_handle, &dig_cfg));
+    s_lock = xSemaphoreCreateMutexStatic(&s_lock_mem);
+    // 엔진은 멈춘 상태로 둠: adc_engine_read()가 읽을 때만 켬
+}
+
+esp_err_t adc_engine_read(adc_channel_t channel, int samples, float *raw)
+{
+    if (channel < 0 || channel >= ADC_RING_MAX_CH || s_ring_of_channel[channel] < 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!s_lock) return ESP_ERR_INVALID_STATE;
+    if (samples > ADC_RING_LEN) samples = ADC_RING_LEN;
+
+    int ring = s_ring_of_channel[channel];
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    esp_err_t err = adc_engine_burst(ring, samples);
+    int n = err == ESP_OK ? adc_ring_average(&s_rings[ring], samples, raw) : 0;
+    xSemaphoreGive(s_lock);
+
+    if (err != ESP_OK) return err;
+    return n > 0 ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
+esp_err_t adc_engine_read_filtered(adc_channel_t channel, const sensor_filter_cfg_t *cfg,
+                                   sensor_filter_t *state, float *raw, int64_t *busy_us)
+{
+    float bursts[SENSOR_FILTER_MAX_MEDIAN];
+    int n = cfg->median_n;
+    if (n < 1) n = 1;
+    if (n > SENSOR_FILTER_MAX_MEDIAN) n = SENSOR_FILTER_MAX_MEDIAN;
+
+    int64_t busy = 0;
+    for (int i = 0; i < n; i++) {
+        if (i > 0) vTaskDelay(pdMS_TO_TICKS(cfg->burst_gap_ms));
+        int64_t t0 = esp_timer_get_time();
+        esp_err_t err = adc_engine_read(channel, ADC_BURST_SAMPLES, &bursts[i]);
+        busy += esp_timer_get_time() - t0;
+        if (err != ESP_OK) return err;
+    }
+
+    *raw = sensor_filter_ema(state, cfg->ema_alpha, sensor_filter_median(bursts, n));
+    if (busy_us) *busy_us = busy;
+    return ESP_OK;
 }
+
+static_assert(sizeof(adc_mv_lut) + sizeof(s_handle) + sizeof(s_rings) + sizeof(s_ring_of_channel) + sizeof(s_lock) +
+              sizeof(s_lock_mem) + sizeof(s_frame) + sizeof(s_lut_mem) + sizeof(s_lut_used) <= ADC_SHARED_STATIC_BYTES,
+              "adc_shared.cpp statics outgrew ADC_SHARED_STATIC_BYTES (adc_shared.h)");
@@ -1,5 +1,41 @@
 #pragma once
-#include <esp_adc/adc_oneshot.h>
+#include <stddef.h>
+#include <esp_err.h>
+#include <hal/adc_types.h>
+#include "app_memory_config.h"
+#include "adc_ring.h"
+#include "sensor_filter.h"
 
-extern adc_oneshot_unit_handle_t adc_handle;
-void init_shared_adc();  // 공통 초기화 함수
+#define ADC_SENSOR_ATTEN  ADC_ATTEN_DB_12  // 모든 아날로그 센서 채널 감쇠 (0 ~ ~3.1 V)
+#define ADC_RAW_MAX       4095             // 12 bit
+#define ADC_ATTEN_COUNT   (ADC_ATTEN_DB_12 + 1)
+#define ADC_ENGINE_MAX_CHANNELS 2          // 엔진이 샘플링하는 채널 수 상한 (채널별 ring 정적 영역)
+
+// 감쇠별 raw -> mV 테이블. init_shared_adc()에서 보드 eFuse 보정값으로 한 번 채움 (사용하는 감쇠만)
+extern uint16_t *adc_mv_lut[ADC_ATTEN_COUNT];
+
+// ADC1 연속(DMA) 모드 엔진. 읽을 때만 켜서 등록된 채널을 샘플링하고 채널별 ring buffer에 나눠 담음
+void init_shared_adc();  // 공통 초기화 함수 (엔진 설정, 멈춘 상태)
+
+// 엔진을 켜서 새로 변환한 samples개 raw 값 평균 (최대 ADC_RING_LEN). 호출한 태스크에서 DMA 프레임을 읽고 다시 끔
+esp_err_t adc_engine_read(adc_channel_t channel, int samples, float *raw);
+
+// mains 한 주기 burst를 median_n번 읽어서 median -> EMA 적용한 raw 값.
+// busy_us (NULL 가능): burst 사이 대기를 뺀 읽기 시간 합 (latency "sample" 단계)
+esp_err_t adc_engine_read_filtered(adc_channel_t channel, const sensor_filter_cfg_t *cfg,
+                                   sensor_filter_t *state, float *raw, int64_t *busy_us);
+
+// 이 모듈의 정적 RAM 상한 (mV 테이블, 채널 ring, DMA 프레임, 채널 -> ring 표, lock + 상태 64 byte).
+// app_memory RAM map 용
+#define ADC_SHARED_STATIC_BYTES \
+    (APP_ADC_LUT_COUNT * (ADC_RAW_MAX + 1) * sizeof(uint16_t) + ADC_ENGINE_MAX_CHANNELS * sizeof(adc_ring_t) + \
+     APP_ADC_FRAME_SIZE + ADC_RING_MAX_CH + sizeof(StaticSemaphore_t) + 64)
+
+// 보정 드라이버 호출 없이 테이블 조회만
+static inline int adc_raw_to_mv(adc_atten_t atten, float raw)
+{
+    int i = (int)(raw + 0.5f);
+    if (i < 0) i = 0;
+    if (i > ADC_RAW_MAX) i = ADC_RAW_MAX;
+    return adc_mv_lut[atten][i];
+}
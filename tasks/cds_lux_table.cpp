@@ -0,0 +1,68 @@
+// CdS 전압(mV) -> lux 테이블. sensor_convert.h 의 CDS_* 상수로 컴파일 타임에 생성 (.rodata, 런타임 계산 없음)
+
+#include "sensor_convert.h"
+
+namespace {
+
+// 컴파일 타임용 ln/exp (std::log/std::exp 는 C++17에서 constexpr 아님)
+constexpr double kLn2 = 0.69314718055994530942;
+
+constexpr double ct_ln(double x)
+{
+    int k = 0;
+    while (x >= 2.0) { x /= 2.0; k++; }
+    while (x < 1.0) { x *= 2.0; k--; }
+
+    // ln(x) = 2 atanh((x-1)/(x+1)), x in [1,2) -> s <= 1/3
+    double s = (x - 1.0) / (x + 1.0);
+    double s2 = s * s, term = s, sum = 0.0;
+    for (int n = 1; n < 60; n += 2) {
+        sum += term / n;
+        term *= s2;
+    }
+    return 2.0 * sum + k * kLn2;
+}
+
+constexpr double ct_exp(double y)
+{
+    int n = (int)(y / kLn2 + (y < 0 ? -0.5 : 0.5));
+    double r = y - n * kLn2;  // |r| <= ln2/2
+
+    double term = 1.0, sum = 1.0;
+    for (int i = 1; i < 30; i++) {
+        term *= r / i;
+        sum += term;
+    }
+    for (; n > 0; n--) sum *= 2.0;
+    for (; n < 0; n++) sum /= 2.0;
+    return sum;
+}
+
+// cds_mv_to_lux() 와 같은 식, 결과는 0.01 lux 단위
+constexpr uint32_t lux_centi(int mv)
+{
+    double voltage = mv / 1000.0;
+    double r_cds = voltage * CDS_R1 / (CDS_VIN - voltage);
+    if (r_cds < 1.0) r_cds = 1;
+
+    double lux = CDS_LUX_GAIN * ct_exp(CDS_LUX_SLOPE * ct_ln(r_cds));
+    return (uint32_t)(lux * 100.0 + 0.5);
+}
+
+constexpr cds_lux_table_t make_table()
+{
+    cds_lux_table_t table = {};
+    for (int mv = 0; mv < CDS_LUX_TABLE_LEN; mv++) {
+        table.centi_lux[mv] = lux_centi(mv);
+    }
+    return table;
+}
+
+constexpr cds_lux_table_t kTable = make_table();
+
+static_assert(kTable.centi_lux[0] == 398107100u, "r_cds clamps to 1 ohm at 0 mV");
+static_assert(kTable.centi_lux[CDS_LUX_TABLE_LEN - 1] < 100u, "table must end near 0 lux");
+
+} // namespace
+
+extern "C" const cds_lux_table_t cds_lux_table = kTable;
@@ -5,9 +5,7 @@
 extern "C" {
 #endif
 
-void cds_sensor_notification(uint16_t endpoint_id, float illuminance, void *user_data);
-
-void cds_task(void *arg);
+void cds_sample(void *ep);
 
 #ifdef __cplusplus
 }
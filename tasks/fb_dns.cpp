@@ -0,0 +1,66 @@
+#include "fb_dns.h"
+#include "sdkconfig.h"
+#include <esp_log.h>
+#include <esp_timer.h>
+#include "lwip/netdb.h"
+#include "lwip/sockets.h"
+#include <string.h>
+
+#ifndef CONFIG_FB_DNS_CACHE_TTL_S
+#define CONFIG_FB_DNS_CACHE_TTL_S 0
+#endif
+
+static const char *TAG = "fb_dns";
+
+// uploader 태스크에서만 씀 (stats만 다른 태스크에서 읽음)
+static char s_host[96];
+static char s_ip[16];
+static int64_t s_expires_us;
+static fb_dns_stats_t s_stats;
+
+bool fb_dns_resolve(const char *host, char *ip, size_t len)
+{
+    int64_t now = esp_timer_get_time();
+    if (s_ip[0] && now < s_expires_us && strcmp(host, s_host) == 0) {
+        s_stats.hits++;
+        strncpy(ip, s_ip, len);
+        ip[len - 1] = '\0';
+        return true;
+    }
+
+    s_stats.misses++;
+    struct addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo *res = NULL;
+
+    int64_t t0 = esp_timer_get_time();
+    if (getaddrinfo(host, NULL, &hints, &res) != 0 || !res) {
+        s_stats.failures++;
+        ESP_LOGW(TAG, "lookup %s failed", host);
+        return false;
+    }
+
+    const struct sockaddr_in *sin = (const struct sockaddr_in *)res->ai_addr;
+    inet_ntoa_r(sin->sin_addr, s_ip, sizeof(s_ip));
+    freeaddrinfo(res);
+
+    strncpy(s_host, host, sizeof(s_host) - 1);
+    s_expires_us = now + (int64_t)CONFIG_FB_DNS_CACHE_TTL_S * 1000000;
+    ESP_LOGI(TAG, "%s -> %s (%d ms, cached %d s)", host, s_ip,
+             (int)((esp_timer_get_time() - t0) / 1000), CONFIG_FB_DNS_CACHE_TTL_S);
+
+    strncpy(ip, s_ip, len);
+    ip[len - 1] = '\0';
+    return true;
+}
+
+void fb_dns_invalidate(void)
+{
+    s_ip[0] = '\0';
+}
+
+void fb_dns_get_stats(fb_dns_stats_t *out)
+{
+    *out = s_stats;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+// uploader용 DNS 캐시 (host 하나). TTL 동안은 다시 조회하지 않고, 연결이 실패하면 바로 버림
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;     // 실제로 조회한 횟수
+    uint32_t failures;   // 조회 실패
+} fb_dns_stats_t;
+
+// host의 IPv4 주소 문자열을 ip에. 실패하면 false (호출자는 host 이름으로 연결)
+bool fb_dns_resolve(const char *host, char *ip, size_t len);
+
+// 캐시 비우기 (연결 실패 시: 주소가 바뀌었을 수 있음)
+void fb_dns_invalidate(void);
+
+void fb_dns_get_stats(fb_dns_stats_t *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,184 @@
+#include "fb_encoder.h"
+#include <math.h>
+#include <string.h>
+
+static inline void put(fb_buf_t *b, const void *p, size_t n)
+{
+    if (b->len + n > b->cap) {
+        b->overflow = true;
+        return;
+    }
+    memcpy(b->data + b->len, p, n);
+    b->len += n;
+}
+
+static inline void put_byte(fb_buf_t *b, uint8_t c)
+{
+    if (b->len >= b->cap) {
+        b->overflow = true;
+        return;
+    }
+    b->data[b->len++] = c;
+}
+
+/* ---- JSON ---- */
+
+static void put_uint_dec(fb_buf_t *b, uint64_t v)
+{
+    char tmp[20];
+    int n = 0;
+    do {
+        tmp[n++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v);
+    while (n) put_byte(b, (uint8_t)tmp[--n]);
+}
+
+static void json_str(fb_buf_t *b, const char *s)
+{
+    put_byte(b, '"');
+    put(b, s, strlen(s));
+    put_byte(b, '"');
+}
+
+static void json_map_begin(fb_buf_t *b, uint32_t count)
+{
+    put_byte(b, '{');
+    if (b->depth < FB_ENC_MAX_DEPTH) b->first[b->depth] = true;
+    b->depth++;
+}
+
+static void json_map_end(fb_buf_t *b)
+{
+    put_byte(b, '}');
+    if (b->depth) b->depth--;
+}
+
+static void json_key(fb_buf_t *b, const char *key)
+{
+    uint8_t d = b->depth ? b->depth - 1 : 0;
+    if (d < FB_ENC_MAX_DEPTH) {
+        if (!b->first[d]) put_byte(b, ',');
+        b->first[d] = false;
+    }
+    json_str(b, key);
+    put_byte(b, ':');
+}
+
+static void json_f32(fb_buf_t *b, float v, uint8_t decimals)
+{
+    static const uint32_t k_pow10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000 };
+
+    if (!isfinite(v)) {
+        put(b, "null", 4);
+        return;
+    }
+    if (decimals > 6) decimals = 6;
+
+    uint32_t scale = k_pow10[decimals];
+    double scaled = (double)v * scale;
+    if (scaled < 0) {
+        put_byte(b, '-');
+        scaled = -scaled;
+    }
+    uint64_t fixed = (uint64_t)(scaled + 0.5);
+    put_uint_dec(b, fixed / scale);
+    if (decimals == 0) return;
+
+    put_byte(b, '.');
+    uint32_t frac = (uint32_t)(fixed % scale);
+    for (uint32_t d = scale / 10; d; d /= 10) {
+        put_byte(b, (uint8_t)('0' + (frac / d) % 10));
+    }
+}
+
+static void json_boolean(fb_buf_t *b, bool v)
+{
+    if (v) put(b, "true", 4);
+    else put(b, "false", 5);
+}
+
+static void json_u32(fb_buf_t *b, uint32_t v)
+{
+    put_uint_dec(b, v);
+}
+
+static void json_finish(fb_buf_t *b)
+{
+    if (b->len < b->cap) b->data[b->len] = '\0';
+    else b->overflow = true;
+}
+
+const fb_encoder_t fb_json_encoder = {
+    "application/json", true,
+    json_map_begin, json_map_end, json_key, json_str, json_f32, json_boolean, json_u32, json_finish,
+};
+
+/* ---- CBOR (RFC 8949) ---- */
+
+static void cbor_head(fb_buf_t *b, uint8_t major, uint32_t v)
+{
+    major <<= 5;
+    if (v < 24) {
+        put_byte(b, major | (uint8_t)v);
+    } else if (v <= 0xFF) {
+        put_byte(b, major | 24);
+        put_byte(b, (uint8_t)v);
+    } else if (v <= 0xFFFF) {
+        put_byte(b, major | 25);
+        put_byte(b, (uint8_t)(v >> 8));
+        put_byte(b, (uint8_t)v);
+    } else {
+        put_byte(b, major | 26);
+        put_byte(b, (uint8_t)(v >> 24));
+        put_byte(b, (uint8_t)(v >> 16));
+        put_byte(b, (uint8_t)(v >> 8));
+        put_byte(b, (uint8_t)v);
+    }
+}
+
+static void cbor_map_begin(fb_buf_t *b, uint32_t count)
+{
+    cbor_head(b, 5, count);
+}
+
+static void cbor_map_end(fb_buf_t *b)
+{
+}
+
+static void cbor_str(fb_buf_t *b, const char *s)
+{
+    size_t n = strlen(s);
+    cbor_head(b, 3, (uint32_t)n);
+    put(b, s, n);
+}
+
+static void cbor_f32(fb_buf_t *b, float v, uint8_t decimals)
+{
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    put_byte(b, 0xFA);
+    put_byte(b, (uint8_t)(bits >> 24));
+    put_byte(b, (uint8_t)(bits >> 16));
+    put_byte(b, (uint8_t)(bits >> 8));
+    put_byte(b, (uint8_t)bits);
+}
+
+static void cbor_boolean(fb_buf_t *b, bool v)
+{
+    put_byte(b, v ? 0xF5 : 0xF4);
+}
+
+static void cbor_u32(fb_buf_t *b, uint32_t v)
+{
+    cbor_head(b, 0, v);
+}
+
+static void cbor_finish(fb_buf_t *b)
+{
+}
+
+const fb_encoder_t fb_cbor_encoder = {
+    "application/cbor", false,
+    cbor_map_begin, cbor_map_end, cbor_str, cbor_str, cbor_f32, cbor_boolean, cbor_u32, cbor_finish,
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+// 텔레메트리 body 인코더. 재사용 버퍼(fb_buf_t)에 바로 append 하고 snprintf 는 쓰지 않음.
+// JSON (Firebase) 과 CBOR (로컬 gateway) 두 가지, 빌드 시 Kconfig 로 선택. ESP-IDF 의존성 없음
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FB_ENC_MAX_DEPTH 4
+
+typedef struct {
+    uint8_t *data;
+    size_t   cap;
+    size_t   len;
+    bool     overflow;                  // cap 을 넘겨서 잘림
+    uint8_t  depth;                     // JSON: 현재 map 깊이
+    bool     first[FB_ENC_MAX_DEPTH];   // JSON: 이 깊이에서 아직 key 가 없음 (',' 생략)
+} fb_buf_t;
+
+static inline void fb_buf_init(fb_buf_t *b, void *mem, size_t cap)
+{
+    b->data = (uint8_t *)mem;
+    b->cap = cap;
+    b->len = 0;
+    b->overflow = false;
+    b->depth = 0;
+}
+
+static inline void fb_buf_reset(fb_buf_t *b)
+{
+    fb_buf_init(b, b->data, b->cap);
+}
+
+typedef struct {
+    const char *content_type;
+    bool        text;  // 로그에 그대로 찍을 수 있는 포맷인지
+    void (*map_begin)(fb_buf_t *b, uint32_t count);  // count: CBOR map 길이
+    void (*map_end)(fb_buf_t *b);
+    void (*key)(fb_buf_t *b, const char *key);
+    void (*str)(fb_buf_t *b, const char *s);         // escape 없음: 내부 상수 문자열만
+    void (*f32)(fb_buf_t *b, float v, uint8_t decimals);  // decimals: JSON 소수 자리수 (half-up 반올림, 최대 6)
+    void (*boolean)(fb_buf_t *b, bool v);
+    void (*u32)(fb_buf_t *b, uint32_t v);
+    void (*finish)(fb_buf_t *b);                     // JSON: NUL 종료 (len 에는 포함 안 됨)
+} fb_encoder_t;
+
+extern const fb_encoder_t fb_json_encoder;
+extern const fb_encoder_t fb_cbor_encoder;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,10 @@
+#include "fb_keys.h"
+#include <string.h>
+
+fb_key_t fb_key_find(const char *name)
+{
+    for (int i = 0; i < FB_KEY_COUNT; i++) {
+        if (strcmp(fb_key_table[i].name, name) == 0) return (fb_key_t)i;
+    }
+    return FB_KEY_COUNT;
+}
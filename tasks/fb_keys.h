@@ -0,0 +1,75 @@
+#pragma once
+
+// 업로드하는 값(key)들의 compile-time 테이블. 센서 하나 추가 = enum 하나 + 행 하나.
+// enum 순서가 오프라인 flash 로그에 저장되는 key 번호이므로 새 key는 FB_KEY_COUNT 바로 앞에만 추가
+
+#include <stdint.h>
+
+typedef enum {
+    FB_KEY_TEMPERATURE = 0,
+    FB_KEY_HUMIDITY,
+    FB_KEY_SOIL_MOISTURE,
+    FB_KEY_LIGHT_INTENSITY,
+    FB_KEY_LED_STATUS,
+    FB_KEY_HEAT_LED_STATUS,
+    FB_KEY_PUMP_STATUS,
+    FB_KEY_HEAP_MIN_FREE,       // health sampler (낮은 주기)
+    FB_KEY_HEAP_LARGEST_BLOCK,
+    FB_KEY_HEAP_FRAG_PCT,
+    FB_KEY_STACK_MIN_FREE,      // 예전 펌웨어 (태스크 중 최소값) 로그 record 용, 더 보내지 않음
+    FB_KEY_STACK_FREE_UPLOADER, // 태스크별 stack 여유 (health sampler)
+    FB_KEY_STACK_FREE_STREAM,
+    FB_KEY_STACK_FREE_SCHED,
+    FB_KEY_STACK_FREE_CHIP,
+    FB_KEY_COUNT,
+} fb_key_t;
+
+typedef enum {
+    FB_LANE_CONTROL = 0,   // 바로 보냄 (uploader가 요청 사이마다 먼저 확인)
+    FB_LANE_SENSOR,        // batch window 동안 모아서 보냄
+    FB_LANE_COUNT,
+} fb_lane_t;
+
+typedef enum {
+    FB_TYPE_FLOAT = 0,
+    FB_TYPE_BOOL,
+} fb_value_type_t;
+
+typedef struct {
+    const char     *name;          // Firebase key (flash 상수)
+    fb_value_type_t type;
+    fb_lane_t       lane;
+    uint8_t         decimals;      // JSON 소수 자리수 (FLOAT만)
+    float           abs_deadband;  // 보고 정책 기본값 (report_policy_t)
+    float           rel_deadband;
+} fb_key_info_t;
+
+// 크기를 적지 않음: 행이 빠지거나 남으면 아래 static_assert 에서 걸림
+inline constexpr fb_key_info_t fb_key_table[] = {
+    // name                 type           lane             dec  abs      rel
+    { "temperature",       FB_TYPE_FLOAT, FB_LANE_SENSOR,  2,   0.5f,    0.0f  },
+    { "humidity",          FB_TYPE_FLOAT, FB_LANE_SENSOR,  2,   1.0f,    0.0f  },
+    { "soilMoisture",      FB_TYPE_FLOAT, FB_LANE_SENSOR,  2,   1.0f,    0.0f  },
+    { "lightIntensity",    FB_TYPE_FLOAT, FB_LANE_SENSOR,  2,   1.0f,    0.10f },
+    { "ledStatus",         FB_TYPE_BOOL,  FB_LANE_CONTROL, 0,   0.0f,    0.0f  },
+    { "heatLedStatus",     FB_TYPE_BOOL,  FB_LANE_CONTROL, 0,   0.0f,    0.0f  },
+    { "pumpStatus",        FB_TYPE_BOOL,  FB_LANE_CONTROL, 0,   0.0f,    0.0f  },
+    { "heapMinFree",       FB_TYPE_FLOAT, FB_LANE_SENSOR,  0,   1024.0f, 0.0f  },
+    { "heapLargest",       FB_TYPE_FLOAT, FB_LANE_SENSOR,  0,   1024.0f, 0.0f  },
+    { "heapFragPct",       FB_TYPE_FLOAT, FB_LANE_SENSOR,  0,   5.0f,    0.0f  },
+    { "stackMinFree",      FB_TYPE_FLOAT, FB_LANE_SENSOR,  0,   128.0f,  0.0f  },
+    { "stackFreeUploader", FB_TYPE_FLOAT, FB_LANE_SENSOR,  0,   128.0f,  0.0f  },
+    { "stackFreeStream",   FB_TYPE_FLOAT, FB_LANE_SENSOR,  0,   128.0f,  0.0f  },
+    { "stackFreeSched",    FB_TYPE_FLOAT, FB_LANE_SENSOR,  0,   128.0f,  0.0f  },
+    { "stackFreeChip",     FB_TYPE_FLOAT, FB_LANE_SENSOR,  0,   128.0f,  0.0f  },
+};
+
+static_assert(sizeof(fb_key_table) / sizeof(fb_key_table[0]) == FB_KEY_COUNT, "one row per fb_key_t");
+
+constexpr const fb_key_info_t &fb_key_info(fb_key_t key)
+{
+    return fb_key_table[key];
+}
+
+// 이름으로 찾기 (Firebase에서 들어온 key 처리용), 없으면 FB_KEY_COUNT
+fb_key_t fb_key_find(const char *name);
@@ -0,0 +1,72 @@
+#include "fb_offline.h"
+#include "sdkconfig.h"
+#include <esp_log.h>
+#include <esp_partition.h>
+
+static const char *TAG = "fb_offline";
+
+#if CONFIG_FB_OFFLINE_LOG
+
+static flash_log_t s_log;
+static bool s_ready;
+
+static int part_read(void *ctx, uint32_t offset, void *buf, uint32_t len)
+{
+    return esp_partition_read((const esp_partition_t *)ctx, offset, buf, len) == ESP_OK ? 0 : -1;
+}
+
+static int part_write(void *ctx, uint32_t offset, const void *buf, uint32_t len)
+{
+    return esp_partition_write((const esp_partition_t *)ctx, offset, buf, len) == ESP_OK ? 0 : -1;
+}
+
+static int part_erase(void *ctx, uint32_t offset, uint32_t len)
+{
+    return esp_partition_erase_range((const esp_partition_t *)ctx, offset, len) == ESP_OK ? 0 : -1;
+}
+
+flash_log_t *fb_offline_init(void)
+{
+    if (s_ready) return &s_log;
+
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                           ESP_PARTITION_SUBTYPE_ANY,
+                                                           CONFIG_FB_OFFLINE_PARTITION);
+    if (!part) {
+        ESP_LOGW(TAG, "no '%s' partition, offline buffering disabled", CONFIG_FB_OFFLINE_PARTITION);
+        return NULL;
+    }
+
+    flash_log_io_t io = {
+        .ctx = (void *)part,
+        .size = part->size,
+        .sector_size = part->erase_size,
+        .read = part_read,
+        .write = part_write,
+        .erase = part_erase,
+    };
+    if (flash_log_open(&s_log, &io) != 0) {
+        ESP_LOGE(TAG, "open failed");
+        return NULL;
+    }
+
+    s_ready = true;
+    ESP_LOGI(TAG, "%lu records, %lu pending, next seq %lu",
+             (unsigned long)s_log.capacity, (unsigned long)s_log.count, (unsigned long)s_log.next_seq);
+    return &s_log;
+}
+
+flash_log_t *fb_offline_log(void)
+{
+    return s_ready ? &s_log : NULL;
+}
+
+static_assert(sizeof(s_log) + sizeof(s_ready) <= FB_OFFLINE_STATIC_BYTES,
+              "fb_offline.cpp statics outgrew FB_OFFLINE_STATIC_BYTES (fb_offline.h)");
+
+#else
+
+flash_log_t *fb_offline_init(void) { return NULL; }
+flash_log_t *fb_offline_log(void) { return NULL; }
+
+#endif  // CONFIG_FB_OFFLINE_LOG
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <stddef.h>
+#include "sdkconfig.h"
+#include "flash_log.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 오프라인 저장용 flash 로그 (CONFIG_FB_OFFLINE_PARTITION 파티션).
+// 파티션이 없거나 기능이 꺼져 있으면 NULL
+flash_log_t *fb_offline_init(void);
+flash_log_t *fb_offline_log(void);
+
+// 이 모듈의 정적 RAM 상한 (로그 상태 + 8 byte). app_memory RAM map 용
+#if CONFIG_FB_OFFLINE_LOG
+#define FB_OFFLINE_STATIC_BYTES (sizeof(flash_log_t) + 8)
+#else
+#define FB_OFFLINE_STATIC_BYTES 0
+#endif
+
+#ifdef __cplusplus
+}
+#endif
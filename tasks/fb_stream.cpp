@@ -0,0 +1,194 @@
+#include "fb_stream.h"
+#include "sse_parser.h"
+#include "app_memory_config.h"
+#include "sdkconfig.h"
+#include <esp_log.h>
+
+#if CONFIG_FB_STREAM_CONTROL
+
+#include "esp_http_client.h"
+#include "esp_crt_bundle.h"
+#include "esp_system.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <cJSON.h>
+#include <string.h>
+
+#define FB_STREAM_TIMEOUT_MS     45000  // Firebase는 30초마다 keep-alive 이벤트를 보냄
+#define FB_STREAM_BACKOFF_MIN_MS 1000
+#define FB_STREAM_BACKOFF_MAX_MS 60000
+#define FB_STREAM_READ_LEN       APP_FB_STREAM_READ_LEN
+
+static const char *TAG = "fb_stream";
+
+static uint32_t s_heap_bytes;  // fb_stream_heap_bytes()
+
+typedef struct {
+    fb_stream_apply_t apply;
+    bool     snapshot_seen;  // 연결 직후 오는 전체 노드 put
+    bool     reconnect;      // cancel / auth_revoked
+    uint32_t applied;
+} fb_stream_ctx_t;
+
+static char s_buf[FB_STREAM_READ_LEN];  // 스트림 태스크에서만 씀
+static fb_stream_ctx_t s_ctx;
+static sse_parser_t s_parser;
+static StackType_t s_stack[APP_FB_STREAM_STACK];
+static StaticTask_t s_tcb;
+
+static void apply_value(fb_stream_ctx_t *ctx, const char *name, const cJSON *v)
+{
+    bool on;
+    if (cJSON_IsBool(v)) on = cJSON_IsTrue(v);
+    else if (cJSON_IsNumber(v)) on = v->valuedouble != 0;
+    else return;
+
+    // control lane key만 원격으로 바꿀 수 있음
+    fb_key_t key = fb_key_find(name);
+    if (key == FB_KEY_COUNT || fb_key_info(key).lane != FB_LANE_CONTROL) return;
+
+    ESP_LOGI(TAG, "%s -> %d", name, on);
+    ctx->apply(key, on);
+    ctx->applied++;
+}
+
+/* put/patch: {"path":"/","data":{"ledStatus":true,...}} 또는 {"path":"/ledStatus","data":false} */
+static void on_event(void *vctx, const char *event, const char *data, size_t len)
+{
+    fb_stream_ctx_t *ctx = (fb_stream_ctx_t *)vctx;
+
+    if (strcmp(event, "keep-alive") == 0) return;
+    if (strcmp(event, "cancel") == 0 || strcmp(event, "auth_revoked") == 0) {
+        ESP_LOGW(TAG, "stream %s", event);
+        ctx->reconnect = true;
+        return;
+    }
+    bool put = strcmp(event, "put") == 0;
+    if (!put && strcmp(event, "patch") != 0) return;
+
+    cJSON *root = cJSON_ParseWithLength(data, len);
+    if (!root) {
+        ESP_LOGW(TAG, "bad %s payload (%d bytes)", event, (int)len);
+        return;
+    }
+
+    const cJSON *path = cJSON_GetObjectItemCaseSensitive(root, "path");
+    const cJSON *value = cJSON_GetObjectItemCaseSensitive(root, "data");
+    bool whole_node = cJSON_IsString(path) && strcmp(path->valuestring, "/") == 0;
+
+    if (put && whole_node && !ctx->snapshot_seen) {
+        // 연결할 때마다 오는 현재 상태: 그 사이 Matter로 바꾼 값을 덮어쓰지 않도록 적용하지 않음
+        ctx->snapshot_seen = true;
+    } else if (whole_node && cJSON_IsObject(value)) {
+        const cJSON *child;
+        cJSON_ArrayForEach(child, value) {
+            apply_value(ctx, child->string, child);
+        }
+    } else if (cJSON_IsString(path) && path->valuestring[0] == '/') {
+        apply_value(ctx, path->valuestring + 1, value);
+    }
+    cJSON_Delete(root);
+}
+
+/* 연결 하나를 끊길 때까지 읽음. 스트림을 받기 시작했으면 true */
+static bool fb_stream_session(fb_stream_ctx_t *ctx, sse_parser_t *parser)
+{
+    bool streamed = false;
+
+    esp_http_client_config_t cfg = {
+        .url = CONFIG_FB_STREAM_URL,
+        .method = HTTP_METHOD_GET,
+        .timeout_ms = FB_STREAM_TIMEOUT_MS,
+        .crt_bundle_attach = esp_crt_bundle_attach,
+    };
+    esp_http_client_handle_t client = esp_http_client_init(&cfg);
+    if (!client) return false;
+    esp_http_client_set_header(client, "Accept", "text/event-stream");
+
+    // uploader 세션과 별개인 두 번째 TLS 세션: 연결 전후 free heap 으로 비용을 잼
+    uint32_t heap0 = esp_get_free_heap_size();
+
+    // Firebase는 스트리밍 요청을 다른 서버로 redirect 할 수 있음
+    for (int hop = 0; hop < 3; hop++) {
+        if (esp_http_client_open(client, 0) != ESP_OK) break;
+        esp_http_client_fetch_headers(client);
+        int status = esp_http_client_get_status_code(client);
+
+        if (status == 301 || status == 302 || status == 307) {
+            esp_http_client_set_redirection(client);
+            esp_http_client_close(client);
+            continue;
+        }
+        if (status != 200) {
+            ESP_LOGW(TAG, "status %d", status);
+            break;
+        }
+
+        uint32_t heap1 = esp_get_free_heap_size();
+        s_heap_bytes = heap0 > heap1 ? heap0 - heap1 : 0;
+        ESP_LOGI(TAG, "streaming %s, TLS session ~%lu bytes heap, free %lu min_free %lu", CONFIG_FB_STREAM_URL,
+                 (unsigned long)s_heap_bytes, (unsigned long)heap1,
+                 (unsigned long)esp_get_minimum_free_heap_size());
+        streamed = true;
+        sse_parser_reset(parser);
+        ctx->snapshot_seen = false;
+        ctx->reconnect = false;
+
+        int n;
+        while (!ctx->reconnect && (n = esp_http_client_read(client, s_buf, sizeof(s_buf))) > 0) {
+            sse_parser_feed(parser, s_buf, (size_t)n);
+        }
+        break;
+    }
+
+    esp_http_client_close(client);
+    esp_http_client_cleanup(client);
+    return streamed;
+}
+
+static void fb_stream_task(void *pv)
+{
+    fb_stream_ctx_t &ctx = s_ctx;
+    sse_parser_t &parser = s_parser;
+    uint32_t backoff = FB_STREAM_BACKOFF_MIN_MS;
+
+    ctx.apply = (fb_stream_apply_t)pv;
+    sse_parser_init(&parser, on_event, &ctx);
+
+    for (;;) {
+        if (fb_stream_session(&ctx, &parser)) backoff = FB_STREAM_BACKOFF_MIN_MS;
+
+        ESP_LOGW(TAG, "stream closed (%lu events, %lu applied), retry in %lu ms",
+                 (unsigned long)parser.events, (unsigned long)ctx.applied, (unsigned long)backoff);
+        vTaskDelay(pdMS_TO_TICKS(backoff));
+        backoff = backoff * 2 < FB_STREAM_BACKOFF_MAX_MS ? backoff * 2 : FB_STREAM_BACKOFF_MAX_MS;
+    }
+}
+
+void fb_stream_start(fb_stream_apply_t apply)
+{
+    xTaskCreateStatic(fb_stream_task, "fb_stream", APP_FB_STREAM_STACK, (void *)apply,
+                      APP_FB_STREAM_PRIO, s_stack, &s_tcb);
+}
+
+uint32_t fb_stream_heap_bytes(void)
+{
+    return s_heap_bytes;
+}
+
+static_assert(sizeof(s_heap_bytes) + sizeof(s_buf) + sizeof(s_ctx) + sizeof(s_parser) + sizeof(s_stack) +
+              sizeof(s_tcb) <= FB_STREAM_STATIC_BYTES,
+              "fb_stream.cpp statics outgrew FB_STREAM_STATIC_BYTES (fb_stream.h)");
+
+#else
+
+void fb_stream_start(fb_stream_apply_t apply)
+{
+}
+
+uint32_t fb_stream_heap_bytes(void)
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,36 @@
+#pragma once
+
+// Firebase control 노드 streaming(SSE) 수신: 앱에서 바꾼 ledStatus/heatLedStatus/pumpStatus를 바로 적용
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "sdkconfig.h"
+#include "app_memory_config.h"
+#include "fb_keys.h"
+#include "sse_parser.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// key는 control lane key만 (ledStatus / heatLedStatus / pumpStatus). fb_stream 태스크에서 호출됨
+typedef void (*fb_stream_apply_t)(fb_key_t key, bool on);
+
+// 스트리밍 태스크 시작 (CONFIG_FB_STREAM_CONTROL일 때만, 끊기면 backoff 하며 다시 연결)
+void fb_stream_start(fb_stream_apply_t apply);
+
+// 마지막 연결 전후 free heap 차이 = stream TLS 세션이 잡고 있는 heap (근사치, 꺼져 있으면 0)
+uint32_t fb_stream_heap_bytes(void);
+
+// 이 모듈의 정적 RAM 상한 (stack/TCB, 읽기 버퍼, SSE parser + 상태 64 byte). app_memory RAM map 용
+#if CONFIG_FB_STREAM_CONTROL
+#define FB_STREAM_STATIC_BYTES \
+    (APP_TASK_BYTES(APP_FB_STREAM_STACK) + APP_FB_STREAM_READ_LEN + sizeof(sse_parser_t) + 64)
+#else
+#define FB_STREAM_STATIC_BYTES 0
+#endif
+
+#ifdef __cplusplus
+}
+#endif
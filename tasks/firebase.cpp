@@ -1,27 +1,132 @@
 // firebase.cpp
 #include "firebase.h"
+#include "fb_offline.h"
+#include "fb_encoder.h"
+#include "history.h"
+#include "latency.h"
+#include "fb_dns.h"
+#include "wall_clock.h"
+#include "fb_stream.h"
+#include "app_memory_config.h"
+#include "sdkconfig.h"
 #include "esp_log.h"
 #include "esp_http_client.h"
 #include "esp_crt_bundle.h"
+#include "esp_timer.h"
+#include "esp_system.h"
+#include "freertos/task.h"
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
 
 #include "lwip/dns.h"
 #include "lwip/ip_addr.h"
 
+#include <stdio.h>
 #include <string.h>
 
-#define FB_KEY_MAX_LEN    16
+#define FB_RESP_MAX_LEN   APP_FB_RESP_LEN
+#define FB_BODY_MAX_LEN   APP_FB_BODY_LEN
+#define FB_BATCH_MAX_KEYS CONFIG_FB_BATCH_MAX_KEYS
+#define FB_HTTP_TIMEOUT_MS 4000
+#define FB_RETRY_MS       2000   // 전송 실패 후 다음 시도까지 (lane 공통)
+
+#define FIREBASE_HOST     "smart-plant-app-1-default-rtdb.asia-southeast1.firebasedatabase.app"
+#define FIREBASE_BASE_URL "https://" FIREBASE_HOST "/"
+
+/* body 포맷과 보낼 곳은 빌드 시 고정 (URL은 상수라 요청마다 만들지 않음) */
+#if CONFIG_FB_ENCODING_CBOR
+#define FB_ENCODER       fb_cbor_encoder
+#define FB_DATA_URL      CONFIG_FB_GATEWAY_URL "/plant_data"
+#define FB_HISTORY_URL   CONFIG_FB_GATEWAY_URL "/plant_history"
+#define FB_ROLLUP_URL    CONFIG_FB_GATEWAY_URL "/plant_rollup"
+#define FB_DIAG_URL      CONFIG_FB_GATEWAY_URL "/diagnostics"
+#else
+#define FB_ENCODER       fb_json_encoder
+#define FB_DATA_URL      FIREBASE_BASE_URL "plant_data.json"
+#define FB_HISTORY_URL   FIREBASE_BASE_URL "plant_history.json"
+#define FB_ROLLUP_URL    FIREBASE_BASE_URL "plant_rollup.json"
+#define FB_DIAG_URL      FIREBASE_BASE_URL "diagnostics.json"
+#endif
 
-#define FIREBASE_BASE_URL "https://smart-plant-app-1-default-rtdb.asia-southeast1.firebasedatabase.app/"
+/* Firebase로 보낼 때는 캐시한 IP로 연결 (TLS 인증서/SNI는 common_name, Host 헤더는 host 이름) */
+#if !CONFIG_FB_ENCODING_CBOR && CONFIG_FB_DNS_CACHE_TTL_S > 0
+#define FB_USE_DNS_CACHE 1
+#else
+#define FB_USE_DNS_CACHE 0
+#endif
+
+#if CONFIG_FB_OFFLINE_LOG
+#define FB_REPLAY_BATCH       CONFIG_FB_REPLAY_BATCH
+#define FB_REPLAY_INTERVAL_MS CONFIG_FB_REPLAY_INTERVAL_MS
+#else
+#define FB_REPLAY_BATCH       1
+#define FB_REPLAY_INTERVAL_MS 0
+#endif
+/* replay record 하나의 최대 길이 (JSON 기준, CBOR 은 더 짧음):
+ * ,"b65535_4294967295_4294967295":{"k":"<key>","v":<f32>,"b":65535,"u":4294967295}
+ * 벽시계 record ("<time>_<seq>", "t") 는 이보다 짧음. f32 는 부호 + uint64 20자리 + '.' + 소수 6자리 */
+static constexpr size_t fb_key_name_max()
+{
+    size_t max = sizeof("unknown") - 1;
+    for (const fb_key_info_t &k : fb_key_table) {
+        size_t n = 0;
+        while (k.name[n]) n++;
+        if (n > max) max = n;
+    }
+    return max;
+}
+#define FB_REPLAY_NAME_MAX    (sizeof("b65535_4294967295_4294967295") - 1)
+#define FB_JSON_F32_MAX       (1 + 20 + 1 + 6)
+#define FB_REPLAY_REC_MAX     (FB_REPLAY_NAME_MAX + fb_key_name_max() + FB_JSON_F32_MAX + 42)
+#define FB_REPLAY_BODY_MAX    (2 + FB_REPLAY_BATCH * FB_REPLAY_REC_MAX + 1)  // {} + NUL
+static_assert(FB_REPLAY_REC_MAX <= FB_REPLAY_REC_BYTES, "fb_key_table name too long for the replay record budget");
+#define FB_REPLAY_CLOCK_WAIT_S 120  // 부팅 후 이 시간까지는 SNTP 를 기다렸다가 재전송
 
 static const char *TAG = "FIREBASE";
 
+/* key마다 슬롯 하나 (fb_key_t로 바로 인덱싱): 가장 최근 값만 남기고(last writer wins) uploader가 dirty한 것만 가져감.
+ * 이름/lane/타입은 fb_key_table에서 */
+typedef struct {
+    float       value;
+    uint32_t    seq;    // fb_update() 할 때마다 증가
+    bool        dirty;  // 아직 보내지 않은 값이 있음
+    int64_t     dirty_us; // dirty 가 된 시각 (queue wait 측정용)
+} fb_slot_t;
+
+static fb_slot_t s_slots[FB_KEY_COUNT];
+
+static portMUX_TYPE s_slot_mux = portMUX_INITIALIZER_UNLOCKED;
+static SemaphoreHandle_t s_wake;  // fb_update()가 uploader를 깨움
+static StaticSemaphore_t s_wake_mem;
+
+/* lane별 deadline: 첫 값이 dirty 된 뒤 이 시간 안에 보냄 (또는 key가 max_keys개 모이면 바로).
+ * 배열 순서가 우선순위: 앞 lane에 보낼 것이 있으면 뒤 lane은 요청 사이사이 남는 시간에만 */
 typedef struct {
-    char  key[FB_KEY_MAX_LEN];
-    float value;
+    uint32_t deadline_ms;
+    int      max_keys;
+} fb_lane_cfg_t;
+
+static const fb_lane_cfg_t s_lane_cfg[FB_LANE_COUNT] = {
+    { 0, FB_KEY_COUNT },                                 // FB_LANE_CONTROL: 바로
+    { CONFIG_FB_BATCH_WINDOW_MS, FB_BATCH_MAX_KEYS },    // FB_LANE_SENSOR
+};
+static fb_metrics_t s_stats;
+
+/* 슬롯에서 꺼낸 값 (seq로 보내는 동안 덮어써졌는지 확인) */
+typedef struct {
+    uint8_t  slot;
+    uint32_t seq;
+    float    value;
+    int64_t  dirty_us;
 } fb_msg_t;
 
-static QueueHandle_t s_sensor_queue = NULL;
-static QueueHandle_t s_control_queue = NULL;
+/* 한 번의 PATCH로 보낼 key들 */
+typedef struct {
+    fb_msg_t items[FB_KEY_COUNT];
+    int      count;
+} fb_batch_t;
 
 /* DNS 강제 설정 (Wi-Fi 붙은 뒤 한 번 호출) */
 void set_google_dns(void)
@@ -32,106 +137,703 @@ void set_google_dns(void)
     ESP_LOGI("DNS", "Set Google DNS: 8.8.8.8");
 }
 
-/* key 이름으로 bool/float 구분 */
-static bool key_is_bool(const char *key)
-{
-    return (
-        strcmp(key, "ledStatus") == 0 ||
-        strcmp(key, "heatLedStatus") == 0 ||
-        strcmp(key, "pumpStatus") == 0
-    );
-}
+/* uploader가 유지하는 keep-alive 연결 */
+typedef struct {
+    esp_http_client_handle_t client;
+    const char *url;  // 지금 client에 설정된 URL (FB_*_URL 상수)
+    bool     online;  // 마지막 요청 성공 여부
+    bool     fresh;   // 새 연결: 다음 요청이 DNS/TCP/TLS handshake를 포함
+#if FB_USE_DNS_CACHE
+    char     ip[16];             // url_buf를 만든 IP
+    char     url_buf[APP_FB_URL_LEN];  // https://<ip>/<path>
+#endif
+    char     resp[FB_RESP_MAX_LEN];
+    int      resp_len;
+    int64_t  last_us;
+    int64_t  max_us;
+    uint8_t  body[FB_BODY_MAX_LEN];  // 요청 body 버퍼 (매 batch 재사용)
+} fb_conn_t;
 
-/* Firebase PATCH 전송 */
-static esp_err_t firebase_send(const char *key, float value)
+/* 응답 body를 연결 버퍼에 모아두기 (perform()이 body를 읽어버리므로) */
+static esp_err_t fb_http_event(esp_http_client_event_t *evt)
 {
-    char url[256];
-    snprintf(url, sizeof(url), "%splant_data.json", FIREBASE_BASE_URL);
+    fb_conn_t *conn = (fb_conn_t *)evt->user_data;
 
-    char body[128];
-    if (key_is_bool(key)) {
-        snprintf(body, sizeof(body), "{\"%s\":%s}", key, (value == 1) ? "true" : "false");
-    } else {
-        snprintf(body, sizeof(body), "{\"%s\":%.2f}", key, value);
+    if (evt->event_id == HTTP_EVENT_ON_DATA && conn) {
+        int room = (int)sizeof(conn->resp) - 1 - conn->resp_len;
+        int n = evt->data_len < room ? evt->data_len : room;
+        if (n > 0) {
+            memcpy(conn->resp + conn->resp_len, evt->data, n);
+            conn->resp_len += n;
+            conn->resp[conn->resp_len] = '\0';
+        }
     }
+    return ESP_OK;
+}
+
+/* 클라이언트를 한 번만 만들고 이후 PATCH들은 같은 TLS 세션을 재사용 */
+static esp_err_t fb_conn_open(fb_conn_t *conn)
+{
+    if (conn->client) return ESP_OK;
 
     esp_http_client_config_t cfg = {
-        .url = url,
+        .url = FB_DATA_URL,
         .method = HTTP_METHOD_PATCH,
-        .timeout_ms = 4000,
+        .timeout_ms = FB_HTTP_TIMEOUT_MS,
+        .event_handler = fb_http_event,
+        .buffer_size = APP_FB_HTTP_RX_BUF,
+        .buffer_size_tx = APP_FB_HTTP_TX_BUF,
+        .user_data = conn,
+#if FB_USE_DNS_CACHE
+        .common_name = FIREBASE_HOST,
+#endif
         .crt_bundle_attach = esp_crt_bundle_attach,
+        .keep_alive_enable = true,
+#if CONFIG_ESP_TLS_CLIENT_SESSION_TICKETS
+        // 연결이 끊겨도 client를 유지하면 다음 연결은 session ticket으로 짧은 handshake
+        .save_client_session = true,
+#endif
     };
 
-    esp_http_client_handle_t client = esp_http_client_init(&cfg);
-    if (!client) {
+    conn->client = esp_http_client_init(&cfg);
+    conn->url = NULL;
+    conn->fresh = true;
+    if (!conn->client) {
         ESP_LOGE(TAG, "init failed");
         return ESP_FAIL;
     }
+    esp_http_client_set_header(conn->client, "Content-Type", FB_ENCODER.content_type);
+    return ESP_OK;
+}
 
-    esp_http_client_set_header(client, "Content-Type", "application/json");
-    esp_http_client_set_post_field(client, body, strlen(body));
+/* 소켓만 닫고 client(와 TLS session)는 유지. 다음 perform()이 다시 연결 */
+static void fb_conn_close(fb_conn_t *conn)
+{
+    if (!conn->client) return;
+    esp_http_client_close(conn->client);
+    conn->fresh = true;
+#if FB_USE_DNS_CACHE
+    fb_dns_invalidate();
+#endif
+}
 
+/* client를 url로 향하게 함. 같은 host라 URL만 바꿔도 연결은 유지됨 */
+static void fb_conn_set_url(fb_conn_t *conn, const char *url)
+{
+#if FB_USE_DNS_CACHE
+    // 새 연결이면 (캐시된) 주소를 확인하고, 주소나 경로가 바뀐 경우에만 URL을 다시 만듦
+    char ip[sizeof(conn->ip)];
+    if (!conn->fresh) {
+        strcpy(ip, conn->ip);
+    } else if (!fb_dns_resolve(FIREBASE_HOST, ip, sizeof(ip))) {
+        ip[0] = '\0';
+    }
+    if (conn->url == url && strcmp(ip, conn->ip) == 0) return;
 
-    esp_err_t err = esp_http_client_perform(client);
-    int status = esp_http_client_get_status_code(client);
-    
-    char resp[128] = {0};
-    int rlen = esp_http_client_read_response(client, resp, sizeof(resp) - 1);
+    strcpy(conn->ip, ip);
+    if (ip[0]) {
+        snprintf(conn->url_buf, sizeof(conn->url_buf), "https://%s/%s", ip, url + strlen(FIREBASE_BASE_URL));
+        esp_http_client_set_url(conn->client, conn->url_buf);
+        esp_http_client_set_header(conn->client, "Host", FIREBASE_HOST);
+    } else {
+        esp_http_client_set_url(conn->client, url);
+    }
+#else
+    if (conn->url == url) return;
+    esp_http_client_set_url(conn->client, url);
+#endif
+    conn->url = url;
+}
 
-    if (err == ESP_OK) {
-        ESP_LOGI(TAG,
-                 "PATCH %s -> %s | status=%d, resp=%s",
-                 key, body, status, (rlen > 0 ? resp : "<no body>"));
+/* 2xx가 아닌 응답을 status code별로 셈 */
+static void fb_count_status(int status)
+{
+    portENTER_CRITICAL(&s_slot_mux);
+    s_stats.http_failures++;
+    int i = 0;
+    while (i < FB_METRICS_STATUS_SLOTS && s_stats.fail_status[i] && s_stats.fail_status[i] != status) i++;
+    if (i == FB_METRICS_STATUS_SLOTS) {
+        s_stats.fail_other++;   // 다른 code 의 칸에 섞지 않음
     } else {
-        ESP_LOGE(TAG, "HTTP fail: %s", esp_err_to_name(err));
+        if (!s_stats.fail_status[i]) s_stats.fail_status[i] = (uint16_t)status;
+        s_stats.fail_count[i]++;
     }
+    portEXIT_CRITICAL(&s_slot_mux);
+}
+
+/* body 하나를 url에 PATCH. 끊어진 연결이면 한 번 다시 연결해서 재시도 */
+static esp_err_t fb_conn_patch(fb_conn_t *conn, const char *url, const fb_buf_t *body, int *status)
+{
+    esp_err_t err = ESP_FAIL;
+
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (fb_conn_open(conn) != ESP_OK) return ESP_FAIL;
+
+        fb_conn_set_url(conn, url);
+
+        conn->resp_len = 0;
+        conn->resp[0] = '\0';
+        esp_http_client_set_post_field(conn->client, (const char *)body->data, (int)body->len);
+
+        bool fresh = conn->fresh;
+        uint32_t heap0 = fresh ? esp_get_free_heap_size() : 0;
+        int64_t t0 = esp_timer_get_time();
+        err = esp_http_client_perform(conn->client);
+        conn->last_us = esp_timer_get_time() - t0;
+
+        if (err == ESP_OK) {
+            *status = esp_http_client_get_status_code(conn->client);
+            conn->online = true;
+            portENTER_CRITICAL(&s_slot_mux);
+            s_stats.requests++;
+            s_stats.bytes_sent += body->len;
+            portEXIT_CRITICAL(&s_slot_mux);
+            if (*status / 100 != 2) fb_count_status(*status);
+            if (fresh) {
+                // 새 연결의 첫 요청: DNS + TCP + TLS handshake + 요청 한 번.
+                // 연결 전후 free heap 차이로 세션이 계속 잡고 있는 heap 을 잼 (다른 태스크 할당이 섞일 수 있음)
+                uint32_t heap1 = esp_get_free_heap_size();
+                conn->fresh = false;
+                portENTER_CRITICAL(&s_slot_mux);
+                s_stats.tls_heap_bytes = heap0 > heap1 ? heap0 - heap1 : 0;
+                s_stats.connects++;
+                s_stats.connect_us_total += conn->last_us;
+                if (conn->last_us > s_stats.connect_us_max) s_stats.connect_us_max = (uint32_t)conn->last_us;
+                portEXIT_CRITICAL(&s_slot_mux);
+                ESP_LOGI(TAG, "connected in %d ms, TLS session ~%lu bytes heap, free %lu min_free %lu",
+                         (int)(conn->last_us / 1000), (unsigned long)(heap0 > heap1 ? heap0 - heap1 : 0),
+                         (unsigned long)heap1, (unsigned long)esp_get_minimum_free_heap_size());
+            }
+            if (conn->last_us > conn->max_us) conn->max_us = conn->last_us;
+            latency_record(LAT_STAGE_HTTPS, conn->last_us);
+            return ESP_OK;
+        }
 
-    esp_http_client_cleanup(client);
+        // 서버가 idle 연결을 끊었거나 Wi-Fi가 바뀐 경우: 새로 연결
+        ESP_LOGW(TAG, "HTTP fail: %s, reconnecting", esp_err_to_name(err));
+        fb_conn_close(conn);
+        if (attempt == 0) {
+            portENTER_CRITICAL(&s_slot_mux);
+            s_stats.retries++;
+            portEXIT_CRITICAL(&s_slot_mux);
+        }
+    }
+    portENTER_CRITICAL(&s_slot_mux);
+    s_stats.transport_failures++;
+    portEXIT_CRITICAL(&s_slot_mux);
+    conn->online = false;
     return err;
 }
 
+/* lane의 dirty 슬롯을 모두 batch로 옮기고 dirty 해제 */
+static int fb_lane_drain(fb_lane_t lane, fb_batch_t *batch)
+{
+    batch->count = 0;
+    portENTER_CRITICAL(&s_slot_mux);
+    for (int i = 0; i < FB_KEY_COUNT; i++) {
+        fb_slot_t *slot = &s_slots[i];
+        if (fb_key_table[i].lane != lane || !slot->dirty) continue;
+        batch->items[batch->count++] = { (uint8_t)i, slot->seq, slot->value, slot->dirty_us };
+        slot->dirty = false;
+    }
+    portEXIT_CRITICAL(&s_slot_mux);
 
-void fb_queue_init(void) {
-    if (!s_sensor_queue) s_sensor_queue = xQueueCreate(20, sizeof(fb_msg_t));
-    if (!s_control_queue) s_control_queue = xQueueCreate(10, sizeof(fb_msg_t));
+    int64_t now = esp_timer_get_time();
+    for (int i = 0; i < batch->count; i++) {
+        latency_record(LAT_STAGE_QUEUE_WAIT, now - batch->items[i].dirty_us);
+    }
+    return batch->count;
 }
 
-void fb_update(const char *key, float value)
+/* 전송 실패: 그 사이 새 값이 안 들어온 슬롯만 다시 dirty로 (다음 wakeup에 재전송) */
+static void fb_lane_restore(const fb_batch_t *batch)
 {
+    portENTER_CRITICAL(&s_slot_mux);
+    for (int i = 0; i < batch->count; i++) {
+        fb_slot_t *slot = &s_slots[batch->items[i].slot];
+        if (slot->seq == batch->items[i].seq) slot->dirty = true;
+    }
+    portEXIT_CRITICAL(&s_slot_mux);
+}
 
-    if (!s_sensor_queue || !s_control_queue) {
-        fb_queue_init();
+/* lane에 밀린 key 수와 가장 오래된 값이 dirty 된 시각 */
+static int fb_lane_pending(fb_lane_t lane, int64_t *oldest_us)
+{
+    int n = 0;
+    int64_t oldest = INT64_MAX;
+    portENTER_CRITICAL(&s_slot_mux);
+    for (int i = 0; i < FB_KEY_COUNT; i++) {
+        if (fb_key_table[i].lane != lane || !s_slots[i].dirty) continue;
+        n++;
+        if (s_slots[i].dirty_us < oldest) oldest = s_slots[i].dirty_us;
     }
+    portEXIT_CRITICAL(&s_slot_mux);
+    *oldest_us = oldest;
+    return n;
+}
 
-    fb_msg_t msg;
-    memset(&msg, 0, sizeof(msg));
-    strncpy(msg.key, key, FB_KEY_MAX_LEN - 1);
-    msg.value = value;
-    
-    // 제어용 키면 control queue로, 아니면 sensor queue로
-    if (key_is_bool(key)) {
-        xQueueSend(s_control_queue, &msg, 0);
-    } else {
-        xQueueSend(s_sensor_queue, &msg, 0);
+/* batch 전체를 map 하나로: {"k1":v1,"k2":v2,...} (CBOR면 같은 구조의 map) */
+static void fb_batch_encode(const fb_batch_t *batch, fb_buf_t *out)
+{
+    const fb_encoder_t *enc = &FB_ENCODER;
+
+    fb_buf_reset(out);
+    enc->map_begin(out, (uint32_t)batch->count);
+    for (int i = 0; i < batch->count; i++) {
+        const fb_msg_t *m = &batch->items[i];
+        const fb_key_info_t &info = fb_key_table[m->slot];
+        enc->key(out, info.name);
+        if (info.type == FB_TYPE_BOOL) {
+            enc->boolean(out, m->value == 1);
+        } else {
+            enc->f32(out, m->value, info.decimals);
+        }
     }
+    enc->map_end(out);
+    enc->finish(out);
 }
 
-// 제어용 Firebase task (높은 우선순위)
-void firebase_control_task(void *pv) {
-    fb_msg_t msg;
-    for (;;) {
-        if (xQueueReceive(s_control_queue, &msg, portMAX_DELAY) == pdPASS) {
-            firebase_send(msg.key, msg.value);
+/* Firebase PATCH 전송 (batch 하나 = PATCH 하나).
+ * 응답이 2xx가 아니면 실패: 4xx(429 제외)는 다시 보내도 같으므로 ESP_ERR_INVALID_RESPONSE (버림), 나머지는 ESP_FAIL (재시도) */
+static esp_err_t firebase_send(fb_conn_t *conn, const fb_batch_t *batch)
+{
+    fb_buf_t body;
+    fb_buf_init(&body, conn->body, sizeof(conn->body));
+    fb_batch_encode(batch, &body);
+    if (body.overflow) {
+        ESP_LOGE(TAG, "body too long (%d keys)", batch->count);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    int status = 0;
+    esp_err_t err = fb_conn_patch(conn, FB_DATA_URL, &body, &status);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "HTTP fail: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    const char *resp = (conn->resp_len > 0 ? conn->resp : "<no body>");
+    if (status / 100 != 2) {
+        ESP_LOGE(TAG, "PATCH %d keys rejected: status=%d, resp=%s", batch->count, status, resp);
+        return (status / 100 == 4 && status != 429) ? ESP_ERR_INVALID_RESPONSE : ESP_FAIL;
+    }
+
+    ESP_LOGI(TAG,
+             "PATCH %d keys -> %s | %d bytes, status=%d, %d ms, resp=%s",
+             batch->count, FB_ENCODER.text ? (const char *)body.data : "<binary>",
+             (int)body.len, status, (int)(conn->last_us / 1000), resp);
+    return ESP_OK;
+}
+
+
+/* 전송 실패한 센서 값은 flash 로그에 남겨둠 (연결 복구 후 history로 재전송).
+ * 벽시계가 아직 없으면 (부팅 번호, 부팅 후 초) 로 남김 */
+static void fb_offline_store(const fb_batch_t *batch)
+{
+    flash_log_t *log = fb_offline_log();
+    if (!log) return;
+
+    wall_stamp_t now = wall_clock_now();
+    uint8_t flags = now.wall ? FLASH_LOG_F_WALL : 0;
+    for (int i = 0; i < batch->count; i++) {
+        flash_log_append(log, batch->items[i].slot, batch->items[i].value, now.t, now.boot, flags);
+    }
+    ESP_LOGW(TAG, "stored %d readings offline (%lu pending)", batch->count, (unsigned long)log->count);
+}
+
+/* history 항목 이름: 벽시계면 "<time>_<seq>", 아니면 "b<boot>_<uptime>_<seq>" */
+static void fb_record_name(char *out, const uint32_t *parts, int n_parts, bool boot_prefix)
+{
+    char tmp[10];
+    int n = 0;
+
+    if (boot_prefix) *out++ = 'b';
+    for (int p = 0; p < n_parts; p++) {
+        if (p) *out++ = '_';
+        uint32_t v = parts[p];
+        do {
+            tmp[n++] = (char)('0' + v % 10);
+            v /= 10;
+        } while (v);
+        while (n) *out++ = tmp[--n];
+    }
+    *out = '\0';
+}
+
+/* 밀린 로그를 한 번에 FB_REPLAY_BATCH 개씩 plant_history에 PATCH
+ * {"<time>_<seq>":{"k":"temperature","v":23.00,"t":<time>},...}
+ * 벽시계 없이 남긴 record 는 이번 부팅 것이면 지금 시계로 환산하고, 이전 부팅 것은
+ * {"b<boot>_<uptime>_<seq>":{"k":..,"v":..,"b":<boot>,"u":<uptime>}} 로 보냄 */
+static flash_log_rec_t s_replay_recs[FB_REPLAY_BATCH];
+static uint8_t s_replay_body[FB_REPLAY_BODY_MAX];
+
+static void fb_offline_replay(fb_conn_t *conn)
+{
+    const fb_encoder_t *enc = &FB_ENCODER;
+
+    flash_log_t *log = fb_offline_log();
+    if (!log || log->count == 0) return;
+    if (!wall_clock_valid() && esp_timer_get_time() < (int64_t)FB_REPLAY_CLOCK_WAIT_S * 1000000) return;
+
+    int n = flash_log_peek(log, s_replay_recs, FB_REPLAY_BATCH);
+    if (n == 0) return;
+
+    uint16_t boot = wall_clock_boot_id();
+    fb_buf_t body;
+    fb_buf_init(&body, s_replay_body, sizeof(s_replay_body));
+    enc->map_begin(&body, (uint32_t)n);
+    for (int i = 0; i < n; i++) {
+        const flash_log_rec_t *r = &s_replay_recs[i];
+        uint32_t t = r->timestamp;
+        bool wall = (r->flags & FLASH_LOG_F_WALL) != 0;
+        if (!wall && r->boot == boot) {
+            uint32_t w = wall_clock_from_uptime(r->timestamp);
+            if (w) {
+                t = w;
+                wall = true;
+            }
+        }
+
+        char name[FB_REPLAY_NAME_MAX + 1];
+        if (wall) {
+            const uint32_t parts[2] = { t, r->seq };
+            fb_record_name(name, parts, 2, false);
+        } else {
+            const uint32_t parts[3] = { r->boot, t, r->seq };
+            fb_record_name(name, parts, 3, true);
+        }
+        enc->key(&body, name);
+        enc->map_begin(&body, wall ? 3 : 4);
+        enc->key(&body, "k");
+        bool known = r->key < FB_KEY_COUNT;
+        enc->str(&body, known ? fb_key_table[r->key].name : "unknown");
+        enc->key(&body, "v");
+        enc->f32(&body, r->value, known ? fb_key_table[r->key].decimals : 2);
+        if (wall) {
+            enc->key(&body, "t");
+            enc->u32(&body, t);
+        } else {
+            enc->key(&body, "b");
+            enc->u32(&body, r->boot);
+            enc->key(&body, "u");
+            enc->u32(&body, t);
         }
+        enc->map_end(&body);
+    }
+    enc->map_end(&body);
+    enc->finish(&body);
+    if (body.overflow) {
+        // 크기는 최악의 record 기준이라 오지 않아야 함. 와도 로그가 막히지 않도록 가장 오래된 record 를 버림
+        ESP_LOGE(TAG, "replay body too long, dropping seq %lu", (unsigned long)s_replay_recs[0].seq);
+        flash_log_ack(log, 1);
+        return;
+    }
+
+    int status = 0;
+    if (fb_conn_patch(conn, FB_HISTORY_URL, &body, &status) == ESP_OK && status / 100 == 2) {
+        flash_log_ack(log, n);
+        ESP_LOGI(TAG, "replayed %d readings (%d bytes), %lu left, %d ms",
+                 n, (int)body.len, (unsigned long)log->count, (int)(conn->last_us / 1000));
+    }
+}
+
+/* 아직 올리지 않은 닫힌 시간 rollup 이 있으면 가장 오래된 시간부터 plant_rollup에 PATCH
+ * (uploader가 한가할 때만 호출). 측정값별 진행은 2xx 를 받은 뒤에만. 요청을 보냈으면 true */
+static history_upload_t s_rollup_up;   // 측정값별 마지막으로 올린 시간
+static int64_t s_rollup_retry_at_us;  // 거절된 block 은 FB_RETRY_MS 뒤에 다시
+static uint8_t s_rollup_body[FB_BODY_MAX_LEN];
+
+static bool fb_rollup_upload(fb_conn_t *conn)
+{
+    if (esp_timer_get_time() < s_rollup_retry_at_us) return false;
+
+    fb_buf_t body;
+    uint32_t start;
+    uint8_t series;
+    fb_buf_init(&body, s_rollup_body, sizeof(s_rollup_body));
+    if (!history_encode_hour_block(&FB_ENCODER, &body, &s_rollup_up, &start, &series)) return false;
+    if (body.overflow) {
+        ESP_LOGE(TAG, "rollup block too long");
+        history_hour_block_done(&s_rollup_up, start, series);
+        return false;
+    }
+
+    int status = 0;
+    if (fb_conn_patch(conn, FB_ROLLUP_URL, &body, &status) == ESP_OK && status / 100 == 2) {
+        history_hour_block_done(&s_rollup_up, start, series);
+        ESP_LOGI(TAG, "rollup %lu uploaded (%d bytes)", (unsigned long)start, (int)body.len);
+    } else {
+        s_rollup_retry_at_us = esp_timer_get_time() + (int64_t)FB_RETRY_MS * 1000;
+    }
+    return true;
+}
+
+void fb_queue_init(void) {
+    if (!s_wake) s_wake = xSemaphoreCreateBinaryStatic(&s_wake_mem);
+    fb_offline_init();
+}
+
+void fb_update(fb_key_t key, float value)
+{
+    if (!s_wake) {
+        fb_queue_init();
+    }
+
+    if ((unsigned)key >= FB_KEY_COUNT) {
+        portENTER_CRITICAL(&s_slot_mux);
+        s_stats.drops++;
+        portEXIT_CRITICAL(&s_slot_mux);
+        ESP_LOGW(TAG, "unknown key %d dropped", (int)key);
+        return;
+    }
+
+    fb_slot_t *slot = &s_slots[key];
+    fb_lane_t lane = fb_key_table[key].lane;
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&s_slot_mux);
+    if (slot->dirty) s_stats.overwrites++;
+    else slot->dirty_us = now;
+    slot->value = value;
+    slot->seq++;
+    slot->dirty = true;
+    s_stats.updates++;
+    uint8_t pending = 0;
+    for (int j = 0; j < FB_KEY_COUNT; j++) {
+        if (fb_key_table[j].lane == lane && s_slots[j].dirty) pending++;
+    }
+    if (pending > s_stats.pending_hwm[lane]) s_stats.pending_hwm[lane] = pending;
+    portEXIT_CRITICAL(&s_slot_mux);
+
+    // uploader가 lane deadline을 다시 계산하도록 깨움
+    xSemaphoreGive(s_wake);
+}
+
+void fb_get_metrics(fb_metrics_t *out)
+{
+    portENTER_CRITICAL(&s_slot_mux);
+    *out = s_stats;
+    portEXIT_CRITICAL(&s_slot_mux);
+}
+
+#if CONFIG_FB_DIAGNOSTICS_INTERVAL_S > 0
+/* metrics를 diagnostics 노드에 낮은 주기로 mirror (uploader가 한가할 때만 호출). 요청을 보냈으면 true */
+static int64_t s_diag_last_us;
+static uint8_t s_diag_body[FB_BODY_MAX_LEN];
+
+static bool fb_diagnostics_upload(fb_conn_t *conn)
+{
+    const fb_encoder_t *enc = &FB_ENCODER;
+
+    // 첫 mirror 도 부팅 후 한 주기 뒤 (부팅 직후의 빈 counter 는 보내지 않음)
+    int64_t now = esp_timer_get_time();
+    if (!s_diag_last_us) s_diag_last_us = now;
+    if (now - s_diag_last_us < (int64_t)CONFIG_FB_DIAGNOSTICS_INTERVAL_S * 1000000) return false;
+    s_diag_last_us = now;
+
+    fb_metrics_t m;
+    fb_get_metrics(&m);
+
+    int codes = 0;
+    while (codes < FB_METRICS_STATUS_SLOTS && m.fail_status[codes]) codes++;
+
+    fb_buf_t body;
+    fb_buf_init(&body, s_diag_body, sizeof(s_diag_body));
+    enc->map_begin(&body, 11);
+    enc->key(&body, "uptimeS");
+    enc->u32(&body, (uint32_t)(now / 1000000));
+    enc->key(&body, "updates");
+    enc->u32(&body, m.updates);
+    enc->key(&body, "overwrites");
+    enc->u32(&body, m.overwrites);
+    enc->key(&body, "drops");
+    enc->u32(&body, m.drops);
+    enc->key(&body, "hwmControl");
+    enc->u32(&body, m.pending_hwm[FB_LANE_CONTROL]);
+    enc->key(&body, "hwmSensor");
+    enc->u32(&body, m.pending_hwm[FB_LANE_SENSOR]);
+    enc->key(&body, "requests");
+    enc->u32(&body, m.requests);
+    enc->key(&body, "retries");
+    enc->u32(&body, m.retries);
+    enc->key(&body, "transportFailures");
+    enc->u32(&body, m.transport_failures);
+    enc->key(&body, "kBytesSent");
+    enc->u32(&body, (uint32_t)(m.bytes_sent / 1024));
+    enc->key(&body, "httpFailures");
+    enc->map_begin(&body, (uint32_t)codes + (m.fail_other ? 1 : 0));
+    for (int i = 0; i < codes; i++) {
+        char code[8];
+        snprintf(code, sizeof(code), "%u", m.fail_status[i]);
+        enc->key(&body, code);
+        enc->u32(&body, m.fail_count[i]);
+    }
+    if (m.fail_other) {
+        enc->key(&body, "other");
+        enc->u32(&body, m.fail_other);
+    }
+    enc->map_end(&body);
+    enc->map_end(&body);
+    enc->finish(&body);
+    if (body.overflow) return false;
+
+    int status = 0;
+    fb_conn_patch(conn, FB_DIAG_URL, &body, &status);
+    return true;
+}
+#else
+static bool fb_diagnostics_upload(fb_conn_t *conn)
+{
+    (void)conn;
+    return false;
+}
+#endif
+
+#if CONFIG_ENABLE_CHIP_SHELL
+
+static esp_err_t fbstats_cmd(int argc, char **argv)
+{
+    fb_metrics_t m;
+    fb_get_metrics(&m);
+
+    printf("mailbox: updates=%lu overwrites=%lu drops=%lu hwm control=%u sensor=%u\n",
+           (unsigned long)m.updates, (unsigned long)m.overwrites, (unsigned long)m.drops,
+           m.pending_hwm[FB_LANE_CONTROL], m.pending_hwm[FB_LANE_SENSOR]);
+    printf("send: requests=%lu retries=%lu transport_failures=%lu http_failures=%lu bytes=%llu\n",
+           (unsigned long)m.requests, (unsigned long)m.retries, (unsigned long)m.transport_failures,
+           (unsigned long)m.http_failures, (unsigned long long)m.bytes_sent);
+    for (int i = 0; i < FB_METRICS_STATUS_SLOTS && m.fail_status[i]; i++) {
+        printf("  status %u: %lu\n", m.fail_status[i], (unsigned long)m.fail_count[i]);
     }
+    if (m.fail_other) printf("  status other: %lu\n", (unsigned long)m.fail_other);
+    fb_dns_stats_t dns;
+    fb_dns_get_stats(&dns);
+    printf("connect: count=%lu avg=%lu ms max=%lu ms (first request incl. handshake), dns hit=%lu miss=%lu fail=%lu\n",
+           (unsigned long)m.connects,
+           (unsigned long)(m.connects ? m.connect_us_total / m.connects / 1000 : 0),
+           (unsigned long)(m.connect_us_max / 1000),
+           (unsigned long)dns.hits, (unsigned long)dns.misses, (unsigned long)dns.failures);
+    // TLS 세션은 uploader 하나 + (CONFIG_FB_STREAM_CONTROL이면) control stream 하나.
+    // min_free는 두 세션이 동시에 handshake 하던 때까지 포함한 부팅 이후 최저점
+    printf("heap: free=%lu min_free=%lu tls uploader=%lu stream=%lu (held after connect)\n",
+           (unsigned long)esp_get_free_heap_size(), (unsigned long)esp_get_minimum_free_heap_size(),
+           (unsigned long)m.tls_heap_bytes, (unsigned long)fb_stream_heap_bytes());
+    return ESP_OK;
 }
 
-// 센서용 Firebase task (낮은 우선순위)
-void firebase_sensor_task(void *pv) {
-    fb_msg_t msg;
+void firebase_register_commands(void)
+{
+    static const esp_matter::console::command_t cmds[] = {
+        { "fbstats", "Firebase uploader mailbox and send counters", fbstats_cmd },
+    };
+    esp_matter::console::add_commands(cmds, sizeof(cmds) / sizeof(cmds[0]));
+}
+
+#else
+
+void firebase_register_commands(void)
+{
+}
+
+#endif
+
+/* lane 하나의 batch 전송. 실패하면 false: 센서 값은 flash 로그로 (로그가 없으면 슬롯으로) 되돌리고,
+ * control 값은 슬롯으로 되돌려서 FB_RETRY_MS 뒤 다시 보냄 */
+static bool fb_lane_send(fb_conn_t *conn, fb_lane_t lane)
+{
+    fb_batch_t batch;
+    if (fb_lane_drain(lane, &batch) == 0) return true;
+
+    esp_err_t err = firebase_send(conn, &batch);
+    if (err == ESP_OK) return true;
+    // 4xx는 다시 보내도 거절되므로 버림 (fbstats에 남음)
+    if (err == ESP_ERR_INVALID_RESPONSE) return true;
+
+    // 재시도마다 같은 값이 로그에 또 쌓이지 않도록 센서 값은 로그 하나로만 보관
+    if (lane == FB_LANE_SENSOR && fb_offline_log()) fb_offline_store(&batch);
+    else fb_lane_restore(&batch);
+    return false;
+}
+
+// Firebase uploader task: 연결(TLS 세션) 하나로 control lane과 sensor lane을 모두 보냄.
+// 요청 사이마다 control lane을 먼저 확인하므로 control 값은 진행 중인 요청 하나만 기다림.
+// sensor lane은 batch window(또는 key N개)까지 모았다가 보내고,
+// 둘 다 보낼 것이 없을 때 (온라인이면) 시간 rollup / diagnostics / 오프라인 로그 재전송을 요청 하나씩
+static fb_conn_t s_conn;  // body/resp 버퍼가 커서 stack 대신 정적 영역에 둠
+
+static void firebase_uploader_task(void *pv) {
+    fb_conn_t &conn = s_conn;
+    int64_t retry_at_us = 0;  // 실패 직후에는 FB_RETRY_MS 동안 전송 보류
+    int64_t replay_at_us = 0;
+
     for (;;) {
-        if (xQueueReceive(s_sensor_queue, &msg, portMAX_DELAY) == pdPASS) {
-            firebase_send(msg.key, msg.value);
+        int64_t now = esp_timer_get_time();
+        int64_t wake_at = INT64_MAX;
+        bool sent = false;
+
+        for (int lane = 0; lane < FB_LANE_COUNT && !sent; lane++) {
+            int64_t oldest_us;
+            int n = fb_lane_pending((fb_lane_t)lane, &oldest_us);
+            if (n == 0) continue;
+
+            int64_t due = oldest_us + (int64_t)s_lane_cfg[lane].deadline_ms * 1000;
+            if (n >= s_lane_cfg[lane].max_keys) due = now;
+            if (due < retry_at_us) due = retry_at_us;
+
+            if (due > now) {
+                if (due < wake_at) wake_at = due;
+                continue;
+            }
+
+            sent = true;
+            if (!fb_lane_send(&conn, (fb_lane_t)lane)) {
+                retry_at_us = esp_timer_get_time() + (int64_t)FB_RETRY_MS * 1000;
+            }
         }
+        if (sent) continue;  // 보낸 뒤에는 다시 control lane부터
+
+        // 할 일 없음: 온라인이면 rollup / diagnostics / 오프라인 로그 중 요청 하나만 보내고 다시 lane부터.
+        // 셋 다 따로 깨어나지 않고 live batch 뒤의 한가한 틈에 실림
+        if (conn.online) {
+            if (fb_rollup_upload(&conn)) continue;
+            if (fb_diagnostics_upload(&conn)) continue;
+
+            // FB_REPLAY_INTERVAL_MS 마다 오프라인 로그 한 batch
+            flash_log_t *log = fb_offline_log();
+            if (log && log->count > 0) {
+                if (now >= replay_at_us) {
+                    fb_offline_replay(&conn);
+                    replay_at_us = esp_timer_get_time() + (int64_t)FB_REPLAY_INTERVAL_MS * 1000;
+                    continue;
+                }
+                if (replay_at_us < wake_at) wake_at = replay_at_us;
+            }
+        }
+
+        TickType_t wait = portMAX_DELAY;
+        if (wake_at != INT64_MAX) {
+            int64_t ms = (wake_at - now + 999) / 1000;
+            wait = pdMS_TO_TICKS(ms > 0 ? ms : 0);
+            if (wait == 0) wait = 1;
+        }
+        xSemaphoreTake(s_wake, wait);
     }
 }
+
+static StackType_t s_uploader_stack[APP_FB_UPLOADER_STACK];
+static StaticTask_t s_uploader_tcb;
+
+void firebase_uploader_start(void)
+{
+    xTaskCreateStatic(firebase_uploader_task, "fb_uploader", APP_FB_UPLOADER_STACK, NULL,
+                      APP_FB_UPLOADER_PRIO, s_uploader_stack, &s_uploader_tcb);
+}
+
+// 정적 객체 sizeof 합이 firebase.h 의 상한 안인지 (app_memory RAM map 은 그 상한으로 예산을 확인)
+static_assert(sizeof(s_slots) + sizeof(s_wake_mem) + sizeof(s_stats) + sizeof(s_conn) +
+              sizeof(s_replay_recs) + sizeof(s_replay_body) +
+              sizeof(s_rollup_up) + sizeof(s_rollup_retry_at_us) + sizeof(s_rollup_body) +
+#if CONFIG_FB_DIAGNOSTICS_INTERVAL_S > 0
+              sizeof(s_diag_last_us) + sizeof(s_diag_body) +
+#endif
+              sizeof(s_uploader_stack) + sizeof(s_uploader_tcb) <= FIREBASE_STATIC_BYTES,
+              "firebase.cpp statics outgrew FIREBASE_STATIC_BYTES (firebase.h)");
@@ -1,25 +1,71 @@
 // firebase.h
 #pragma once
 
+#include <stddef.h>
 #include "freertos/FreeRTOS.h"
-#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "sdkconfig.h"
+#include "app_memory_config.h"
+#include "fb_keys.h"
+#include "flash_log.h"
 
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#define FB_METRICS_STATUS_SLOTS 6
+
+typedef struct {
+    // mailbox
+    uint32_t updates;              // fb_update() 호출 수
+    uint32_t overwrites;           // 보내기 전에 새 값으로 덮어쓴 횟수
+    uint32_t drops;                // 모르는 key라서 버린 횟수
+    uint8_t  pending_hwm[2];       // lane(control, sensor)별 동시에 밀려 있던 key 수 최대값
+    // 전송
+    uint32_t requests;             // 응답을 받은 PATCH 수 (status 무관)
+    uint32_t retries;              // 연결이 끊겨서 다시 연결해 보낸 횟수
+    uint32_t transport_failures;   // 재시도까지 실패해서 응답이 없었던 횟수
+    uint32_t http_failures;        // 2xx가 아닌 응답 수
+    uint16_t fail_status[FB_METRICS_STATUS_SLOTS];  // 실패 status code (처음 본 순서)
+    uint32_t fail_count[FB_METRICS_STATUS_SLOTS];
+    uint32_t fail_other;           // 칸이 다 찬 뒤에 처음 본 status code 응답 수
+    uint64_t bytes_sent;           // 응답을 받은 요청의 body 바이트 합
+    uint32_t connects;             // 새 연결 수 (처음 연결 + 재연결)
+    uint32_t connect_us_max;       // 새 연결 첫 요청 시간 (DNS + TCP + TLS handshake 포함) 최대값
+    uint64_t connect_us_total;
+    uint32_t tls_heap_bytes;       // 마지막 새 연결 전후 free heap 차이 = uploader TLS 세션이 잡고 있는 heap (근사치)
+} fb_metrics_t;
+
 void set_google_dns(void);
 
-// 큐 초기화 (app_main에서 한 번 호출)
+// 큐(key별 슬롯) 초기화 (app_main에서 한 번 호출)
 void fb_queue_init(void);
 
-// 센서에서 값 들어오면 이거 호출해서 큐에 넣기만
-void fb_update(const char *key, float value);
+// 센서에서 값 들어오면 이거 호출해서 key 슬롯에 최신 값만 남김 (bool key는 0/1)
+void fb_update(fb_key_t key, float value);
+
+void fb_get_metrics(fb_metrics_t *out);
 
-// 큐에서 꺼내서 실제로 Firebase로 보내는 태스크
-void firebase_control_task(void *pv);
-void firebase_sensor_task(void *pv);
+// "fbstats" console 명령 등록 (CONFIG_ENABLE_CHIP_SHELL일 때만)
+void firebase_register_commands(void);
+
+// key 슬롯에서 꺼내서 실제로 Firebase로 보내는 태스크 시작 (연결 하나, control lane 우선).
+// stack/TCB는 정적 할당 (app_memory_config.h)
+void firebase_uploader_start(void);
+
+// 이 모듈의 정적 RAM 상한 (app_memory RAM map). firebase.cpp 가 실제 sizeof 합이 이 안인지 static_assert.
+// uploader stack/TCB, wake 세마포어, 연결 / rollup / diagnostics body, 응답 / URL 버퍼, replay batch,
+// 나머지 (key 슬롯, 통계, 연결 상태) 1 KB
+#define FB_REPLAY_REC_BYTES     128   // replay body 에서 record 하나 (JSON) 의 상한
+#if CONFIG_FB_OFFLINE_LOG
+#define FB_REPLAY_STATIC_BYTES  (CONFIG_FB_REPLAY_BATCH * (sizeof(flash_log_rec_t) + FB_REPLAY_REC_BYTES) + 3)
+#else
+#define FB_REPLAY_STATIC_BYTES  (sizeof(flash_log_rec_t) + FB_REPLAY_REC_BYTES + 3)
+#endif
+#define FIREBASE_STATIC_BYTES \
+    (APP_TASK_BYTES(APP_FB_UPLOADER_STACK) + sizeof(StaticSemaphore_t) + 3 * APP_FB_BODY_LEN + \
+     APP_FB_RESP_LEN + APP_FB_URL_LEN + FB_REPLAY_STATIC_BYTES + 1024)
 
 
 #ifdef __cplusplus
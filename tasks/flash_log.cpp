@@ -0,0 +1,187 @@
+#include "flash_log.h"
+#include <stddef.h>
+#include <string.h>
+
+#define REC_SIZE        sizeof(flash_log_rec_t)
+#define REC_CRC_LEN     offsetof(flash_log_rec_t, state)
+
+static_assert(sizeof(flash_log_rec_t) == 20, "record layout is stored in flash");
+
+static uint16_t crc16(const uint8_t *p, size_t len)
+{
+    uint16_t crc = 0xFFFF;  // CRC-16/CCITT-FALSE
+    while (len--) {
+        crc ^= (uint16_t)(*p++) << 8;
+        for (int i = 0; i < 8; i++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static inline uint32_t per_sector(const flash_log_t *log)
+{
+    return log->io.sector_size / REC_SIZE;
+}
+
+/* record 는 섹터를 넘지 않음 (섹터마다 per_sector 개, 남는 자리는 비움) */
+static uint32_t rec_offset(const flash_log_t *log, uint32_t idx)
+{
+    uint32_t ps = per_sector(log);
+    return (idx / ps) * log->io.sector_size + (idx % ps) * REC_SIZE;
+}
+
+static int read_rec(flash_log_t *log, uint32_t idx, flash_log_rec_t *rec)
+{
+    if (log->io.read(log->io.ctx, rec_offset(log, idx), rec, REC_SIZE) != 0) {
+        log->errors++;
+        return -1;
+    }
+    return 0;
+}
+
+static bool rec_valid(const flash_log_rec_t *rec)
+{
+    return rec->state != FLASH_LOG_EMPTY && rec->format == FLASH_LOG_FORMAT &&
+           rec->crc == crc16((const uint8_t *)rec, REC_CRC_LEN);
+}
+
+static bool rec_blank(const flash_log_rec_t *rec)
+{
+    const uint8_t *p = (const uint8_t *)rec;
+    for (size_t i = 0; i < REC_SIZE; i++) {
+        if (p[i] != 0xFF) return false;
+    }
+    return true;
+}
+
+int flash_log_open(flash_log_t *log, const flash_log_io_t *io)
+{
+    memset(log, 0, sizeof(*log));
+    log->io = *io;
+    if (io->sector_size < REC_SIZE || io->size < io->sector_size) return -1;
+    log->capacity = (io->size / io->sector_size) * per_sector(log);
+
+    // 가장 큰 seq 다음이 head
+    bool any = false;
+    uint32_t max_seq = 0, max_idx = 0;
+    flash_log_rec_t rec;
+    for (uint32_t i = 0; i < log->capacity; i++) {
+        if (read_rec(log, i, &rec) != 0) return -1;
+        if (!rec_valid(&rec)) continue;
+        if (!any || (int32_t)(rec.seq - max_seq) > 0) {
+            max_seq = rec.seq;
+            max_idx = i;
+            any = true;
+        }
+    }
+    if (!any) return 0;
+
+    log->head = (max_idx + 1) % log->capacity;
+    log->next_seq = max_seq + 1;
+
+    // head 다음부터 한 바퀴 돌면서 처음 나오는 미전송 record가 tail (ack 는 항상 앞에서부터)
+    for (uint32_t n = 0; n < log->capacity; n++) {
+        uint32_t i = (log->head + n) % log->capacity;
+        if (read_rec(log, i, &rec) != 0) return -1;
+        if (rec_valid(&rec) && rec.state == FLASH_LOG_PENDING) {
+            log->tail = i;
+            log->count = (log->head + log->capacity - i) % log->capacity;
+            if (log->count == 0) log->count = log->capacity;
+            return 0;
+        }
+    }
+    log->tail = log->head;
+    return 0;
+}
+
+/* head 가 새 섹터 첫 칸이면 그 섹터를 지우고, 거기 남아있던 미전송 record 는 버림 */
+static int prepare_head(flash_log_t *log)
+{
+    uint32_t ps = per_sector(log);
+    if (log->head % ps != 0) {
+        // 쓰다 만 record 가 있던 자리면 건너뜀 (전원 차단 복구)
+        flash_log_rec_t rec;
+        while (log->head % ps != 0) {
+            if (read_rec(log, log->head, &rec) != 0) return -1;
+            if (rec_blank(&rec)) return 0;
+            log->head = (log->head + 1) % log->capacity;
+            if (log->count > 0) log->count++;   // count 는 tail..head 칸 수라 건너뛴 칸도 포함
+        }
+    }
+
+    uint32_t sector = log->head / ps;
+    if (log->count > 0 && log->tail / ps == sector) {
+        uint32_t lost = ps - log->tail % ps;
+        if (lost > log->count) lost = log->count;
+        log->count -= lost;
+        log->dropped += lost;
+        log->tail = ((sector + 1) * ps) % log->capacity;
+    }
+    if (log->io.erase(log->io.ctx, sector * log->io.sector_size, log->io.sector_size) != 0) {
+        log->errors++;
+        return -1;
+    }
+    return 0;
+}
+
+int flash_log_append(flash_log_t *log, uint8_t key, float value, uint32_t timestamp, uint16_t boot, uint8_t flags)
+{
+    if (prepare_head(log) != 0) return -1;
+
+    flash_log_rec_t rec = {};
+    rec.seq = log->next_seq;
+    rec.timestamp = timestamp;
+    rec.value = value;
+    rec.boot = boot;
+    rec.key = key;
+    rec.flags = flags;
+    rec.state = FLASH_LOG_PENDING;
+    rec.format = FLASH_LOG_FORMAT;
+    rec.crc = crc16((const uint8_t *)&rec, REC_CRC_LEN);
+
+    if (log->io.write(log->io.ctx, rec_offset(log, log->head), &rec, REC_SIZE) != 0) {
+        log->errors++;
+        return -1;
+    }
+
+    if (log->count == 0) log->tail = log->head;
+    log->head = (log->head + 1) % log->capacity;
+    log->next_seq++;
+    log->count++;
+    log->appended++;
+    return 0;
+}
+
+int flash_log_peek(flash_log_t *log, flash_log_rec_t *out, int max)
+{
+    int n = 0;
+    uint32_t idx = log->tail;
+    for (uint32_t left = log->count; left > 0 && n < max; left--) {
+        if (read_rec(log, idx, &out[n]) != 0) break;
+        if (rec_valid(&out[n]) && out[n].state == FLASH_LOG_PENDING) n++;
+        idx = (idx + 1) % log->capacity;
+    }
+    return n;
+}
+
+int flash_log_ack(flash_log_t *log, int n)
+{
+    const uint8_t sent = FLASH_LOG_SENT;
+    flash_log_rec_t rec;
+
+    while (n > 0 && log->count > 0) {
+        if (read_rec(log, log->tail, &rec) != 0) return -1;
+        if (rec_valid(&rec) && rec.state == FLASH_LOG_PENDING) {
+            uint32_t off = rec_offset(log, log->tail) + offsetof(flash_log_rec_t, state);
+            if (log->io.write(log->io.ctx, off, &sent, 1) != 0) {
+                log->errors++;
+                return -1;
+            }
+            n--;
+        }
+        log->tail = (log->tail + 1) % log->capacity;
+        log->count--;
+    }
+    return 0;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+// append-only 원형 로그 (고정 크기 record, flash 파티션 위).
+// - 섹터는 로그가 한 바퀴 돌아 다시 그 섹터에 쓸 때만 erase -> 섹터당 erase 횟수가 균일 (wear-aware)
+// - 보낸 record는 state byte 의 bit만 1->0 으로 지워서 표시 (erase 없음)
+// - 부팅 시 전체 스캔으로 head/tail 복구, 쓰다 만 record는 CRC로 걸러냄
+// flash 접근은 flash_log_io_t 콜백으로만 해서 파일 기반 가짜 파티션으로 host 검증 가능
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    void    *ctx;
+    uint32_t size;         // byte, sector_size 의 배수
+    uint32_t sector_size;
+    int (*read)(void *ctx, uint32_t offset, void *buf, uint32_t len);
+    int (*write)(void *ctx, uint32_t offset, const void *buf, uint32_t len);
+    int (*erase)(void *ctx, uint32_t offset, uint32_t len);  // sector 정렬
+} flash_log_io_t;               // 콜백은 성공 시 0
+
+typedef struct {
+    uint32_t seq;        // 0부터 계속 증가
+    uint32_t timestamp;  // FLASH_LOG_F_WALL 이면 unix time, 아니면 boot 번째 부팅 후 초
+    float    value;
+    uint16_t boot;       // 기록한 부팅 번호
+    uint8_t  key;        // key 테이블 인덱스
+    uint8_t  flags;      // FLASH_LOG_F_*
+    uint8_t  state;      // FLASH_LOG_*
+    uint8_t  format;     // FLASH_LOG_FORMAT (layout 이 다른 옛 record 를 걸러냄)
+    uint16_t crc;        // state 앞 16 byte 의 CRC16
+} flash_log_rec_t;      // 섹터 끝에 남는 자리 (4096 % 20 = 16 byte) 는 비워둠
+
+#define FLASH_LOG_EMPTY   0xFF
+#define FLASH_LOG_PENDING 0xFE
+#define FLASH_LOG_SENT    0x00
+
+#define FLASH_LOG_FORMAT  2
+#define FLASH_LOG_F_WALL  0x01   // timestamp 가 SNTP 로 맞춘 벽시계
+
+typedef struct {
+    flash_log_io_t io;
+    uint32_t capacity;   // record 수
+    uint32_t head;       // 다음에 쓸 record 위치
+    uint32_t tail;       // 가장 오래된 미전송 record 위치
+    uint32_t count;      // tail..head 칸 수 = 미전송 record 수 (+ 그 사이 쓰다 만 칸)
+    uint32_t next_seq;
+    uint32_t appended;
+    uint32_t dropped;    // 다 돌아서 덮어쓴 미전송 record
+    uint32_t errors;     // io 실패
+} flash_log_t;
+
+// 파티션을 스캔해서 head/tail 복구. 0 이면 성공
+int flash_log_open(flash_log_t *log, const flash_log_io_t *io);
+
+int flash_log_append(flash_log_t *log, uint8_t key, float value, uint32_t timestamp, uint16_t boot, uint8_t flags);
+
+// tail 부터 최대 max 개의 미전송 record 읽기. 읽은 수 반환
+int flash_log_peek(flash_log_t *log, flash_log_rec_t *out, int max);
+
+// peek 한 앞쪽 n 개를 전송 완료로 표시하고 tail 이동
+int flash_log_ack(flash_log_t *log, int n);
+
+#ifdef __cplusplus
+}
+#endif
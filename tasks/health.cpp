@@ -0,0 +1,174 @@
+#include "health.h"
+#include "firebase.h"
+#include "report_policy.h"
+#include "app_memory_config.h"
+#include "sdkconfig.h"
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <esp_system.h>
+#include <esp_heap_caps.h>
+#include <stdio.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+static const char *TAG = "health";
+
+/* 감시할 태스크. stack 크기는 app_memory_config.h와 같은 값 (0 = 모름, 여유만 표시) */
+typedef struct {
+    const char  *name;
+    uint32_t     stack;
+    fb_key_t     key;        // stack 여유를 게시하는 key
+    TaskHandle_t handle;     // 처음 찾았을 때 저장 (태스크는 지워지지 않음)
+    uint32_t     min_free;   // uxTaskGetStackHighWaterMark (byte)
+} health_task_t;
+
+static health_task_t s_tasks[] = {
+    { "fb_uploader",  APP_FB_UPLOADER_STACK,  FB_KEY_STACK_FREE_UPLOADER, NULL, 0 },
+    { "fb_stream",    APP_FB_STREAM_STACK,    FB_KEY_STACK_FREE_STREAM,   NULL, 0 },
+    { "sensor_sched", APP_SENSOR_SCHED_STACK, FB_KEY_STACK_FREE_SCHED,    NULL, 0 },
+#ifdef CONFIG_CHIP_TASK_STACK_SIZE
+    { "CHIP",         CONFIG_CHIP_TASK_STACK_SIZE, FB_KEY_STACK_FREE_CHIP, NULL, 0 },
+#else
+    { "CHIP",         0,                      FB_KEY_STACK_FREE_CHIP,     NULL, 0 },
+#endif
+};
+#define HEALTH_TASK_COUNT (int)(sizeof(s_tasks) / sizeof(s_tasks[0]))
+
+static health_stats_t s_stats;
+static portMUX_TYPE s_health_mux = portMUX_INITIALIZER_UNLOCKED;
+
+#if CONFIG_FB_HEALTH_INTERVAL_S > 0
+#define HEALTH_PUBLISH_MS ((uint32_t)CONFIG_FB_HEALTH_INTERVAL_S * 1000)
+
+static const fb_key_t s_heap_keys[] = {
+    FB_KEY_HEAP_MIN_FREE, FB_KEY_HEAP_LARGEST_BLOCK, FB_KEY_HEAP_FRAG_PCT,
+};
+#define HEALTH_HEAP_KEYS (int)(sizeof(s_heap_keys) / sizeof(s_heap_keys[0]))
+
+// heap key 다음에 태스크 순서로
+static report_state_t s_report[HEALTH_HEAP_KEYS + HEALTH_TASK_COUNT];
+
+static void health_publish_one(int slot, fb_key_t key, float value, uint64_t now_ms)
+{
+    const fb_key_info_t &info = fb_key_info(key);
+    const report_policy_t policy = { info.abs_deadband, info.rel_deadband,
+                                     HEALTH_PUBLISH_MS, 4 * HEALTH_PUBLISH_MS };
+    if (report_policy_check(&policy, &s_report[slot], value, now_ms)) {
+        fb_update(key, value);
+    }
+}
+
+static void health_publish(const health_stats_t *st)
+{
+    const float heap[HEALTH_HEAP_KEYS] = {
+        (float)st->heap_min_free, (float)st->heap_largest, (float)st->frag_pct,
+    };
+    uint64_t now_ms = (uint64_t)(esp_timer_get_time() / 1000);
+
+    for (int i = 0; i < HEALTH_HEAP_KEYS; i++) health_publish_one(i, s_heap_keys[i], heap[i], now_ms);
+    // 태스크마다 따로: 가장 작은 값 하나로는 어느 태스크가 모자란지 알 수 없음
+    for (int i = 0; i < HEALTH_TASK_COUNT; i++) {
+        const health_task_t *t = &s_tasks[i];
+        if (!t->handle) continue;  // 이 빌드에 없는 태스크 (stream 꺼짐 등)
+        health_publish_one(HEALTH_HEAP_KEYS + i, t->key, (float)t->min_free, now_ms);
+    }
+}
+#else
+static void health_publish(const health_stats_t *st)
+{
+}
+#endif
+
+void health_sample(void *ctx)
+{
+    uint32_t stack_min = UINT32_MAX;
+    for (int i = 0; i < HEALTH_TASK_COUNT; i++) {
+        health_task_t *t = &s_tasks[i];
+        if (!t->handle) t->handle = xTaskGetHandle(t->name);
+        if (!t->handle) continue;  // 아직 시작 전 (또는 이 빌드에 없음)
+
+        // ESP-IDF에서는 word가 아니라 byte 단위
+        t->min_free = uxTaskGetStackHighWaterMark(t->handle);
+        if (t->min_free < stack_min) stack_min = t->min_free;
+    }
+
+    uint32_t free_now = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    uint32_t largest = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    uint8_t frag = free_now ? (uint8_t)(100 - (uint64_t)largest * 100 / free_now) : 0;
+
+    portENTER_CRITICAL(&s_health_mux);
+    s_stats.heap_free = free_now;
+    s_stats.heap_min_free = esp_get_minimum_free_heap_size();
+    s_stats.heap_largest = largest;
+    s_stats.frag_pct = frag;
+    if (frag > s_stats.frag_pct_max) s_stats.frag_pct_max = frag;
+    s_stats.stack_min_free = stack_min == UINT32_MAX ? 0 : stack_min;
+    s_stats.samples++;
+    health_stats_t st = s_stats;
+    portEXIT_CRITICAL(&s_health_mux);
+
+    if (st.stack_min_free && st.stack_min_free < 512) {
+        ESP_LOGW(TAG, "stack headroom down to %lu bytes", (unsigned long)st.stack_min_free);
+    }
+    health_publish(&st);
+}
+
+void health_get_stats(health_stats_t *out)
+{
+    portENTER_CRITICAL(&s_health_mux);
+    *out = s_stats;
+    portEXIT_CRITICAL(&s_health_mux);
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+
+static esp_err_t health_cmd(int argc, char **argv)
+{
+    // stack/heap은 명령 시점 값, 최대 fragmentation은 샘플러 통계 (여기서는 publish 안 함)
+    health_stats_t st;
+    health_get_stats(&st);
+
+    printf("%-12s %6s %8s %5s\n", "task", "stack", "min_free", "used%");
+    for (int i = 0; i < HEALTH_TASK_COUNT; i++) {
+        const health_task_t *t = &s_tasks[i];
+        if (!t->handle) {
+            printf("%-12s %6lu %8s\n", t->name, (unsigned long)t->stack, "-");
+            continue;
+        }
+        uint32_t min_free = uxTaskGetStackHighWaterMark(t->handle);
+        if (t->stack) {
+            printf("%-12s %6lu %8lu %4lu%%\n", t->name, (unsigned long)t->stack, (unsigned long)min_free,
+                   (unsigned long)((t->stack - min_free) * 100 / t->stack));
+        } else {
+            printf("%-12s %6s %8lu\n", t->name, "?", (unsigned long)min_free);
+        }
+    }
+    uint32_t free_now = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    uint32_t largest = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    printf("heap: free=%lu min_free=%lu largest=%lu frag=%lu%% (max sampled %u%%, %lu samples)\n",
+           (unsigned long)free_now, (unsigned long)esp_get_minimum_free_heap_size(), (unsigned long)largest,
+           (unsigned long)(free_now ? 100 - (uint64_t)largest * 100 / free_now : 0),
+           st.frag_pct_max, (unsigned long)st.samples);
+    return ESP_OK;
+}
+
+void health_register_commands(void)
+{
+    static const esp_matter::console::command_t cmds[] = {
+        { "health", "Task stack high-water marks and heap fragmentation. Usage: health", health_cmd },
+    };
+    esp_matter::console::add_commands(cmds, sizeof(cmds) / sizeof(cmds[0]));
+}
+
+#else
+
+void health_register_commands(void)
+{
+}
+
+#endif
@@ -0,0 +1,32 @@
+#pragma once
+
+// 태스크 stack high-water mark + heap 상태 주기 샘플링.
+// console "health"로 보고, CONFIG_FB_HEALTH_INTERVAL_S 주기로 fb_update()에 게시
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t heap_free;
+    uint32_t heap_min_free;      // 부팅 후 최소 (esp_get_minimum_free_heap_size)
+    uint32_t heap_largest;       // 가장 큰 free block
+    uint8_t  frag_pct;           // 100 * (1 - largest / free)
+    uint8_t  frag_pct_max;       // 샘플 중 최대
+    uint32_t stack_min_free;     // 감시 태스크 중 가장 작은 stack 여유 (byte)
+    uint32_t samples;
+} health_stats_t;
+
+// sensor scheduler 콜백 (1분 주기 권장). 스케줄러 태스크에서만 호출
+void health_sample(void *ctx);
+
+void health_get_stats(health_stats_t *out);
+
+// "health" console 명령 등록 (CONFIG_ENABLE_CHIP_SHELL일 때만)
+void health_register_commands(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,74 @@
+#include "hist_ring.h"
+#include <string.h>
+
+static const uint32_t k_span_s[HIST_LEVEL_COUNT] = { 60, 3600 };
+static const uint16_t k_len[HIST_LEVEL_COUNT]    = { HIST_MINUTE_LEN, HIST_HOUR_LEN };
+
+static inline hist_rollup_t *level_buf(hist_ring_t *h, int level)
+{
+    return level == HIST_LEVEL_MINUTE ? h->minute : h->hour;
+}
+
+static inline const hist_rollup_t *level_buf(const hist_ring_t *h, int level)
+{
+    return level == HIST_LEVEL_MINUTE ? h->minute : h->hour;
+}
+
+void hist_ring_init(hist_ring_t *h)
+{
+    memset(h, 0, sizeof(*h));
+}
+
+static void rollup_add(hist_ring_t *h, int level, float value, uint32_t t)
+{
+    hist_rollup_t *open = &h->open[level];
+    uint32_t start = t - t % k_span_s[level];
+
+    if (open->count && open->start != start) {
+        level_buf(h, level)[h->head[level]] = *open;
+        h->head[level] = (uint16_t)((h->head[level] + 1) % k_len[level]);
+        if (h->count[level] < k_len[level]) h->count[level]++;
+        open->count = 0;
+    }
+
+    if (open->count == 0) {
+        open->start = start;
+        open->min = open->max = open->sum = value;
+        open->count = 1;
+        return;
+    }
+    if (value < open->min) open->min = value;
+    if (value > open->max) open->max = value;
+    open->sum += value;
+    open->count++;
+}
+
+void hist_ring_add(hist_ring_t *h, float value, uint32_t t)
+{
+    h->raw[h->raw_head] = { value, t };
+    h->raw_head = (uint16_t)((h->raw_head + 1) % HIST_RAW_LEN);
+    if (h->raw_count < HIST_RAW_LEN) h->raw_count++;
+
+    for (int level = 0; level < HIST_LEVEL_COUNT; level++) {
+        rollup_add(h, level, value, t);
+    }
+    h->samples++;
+}
+
+const hist_sample_t *hist_ring_sample(const hist_ring_t *h, int idx)
+{
+    if (idx < 0 || idx >= h->raw_count) return NULL;
+    return &h->raw[(h->raw_head + HIST_RAW_LEN - 1 - idx) % HIST_RAW_LEN];
+}
+
+const hist_rollup_t *hist_ring_rollup(const hist_ring_t *h, hist_level_t level, int idx)
+{
+    if (idx < 0 || idx >= h->count[level]) return NULL;
+    uint16_t len = k_len[level];
+    return &level_buf(h, level)[(h->head[level] + len - 1 - idx) % len];
+}
+
+int hist_ring_rollup_count(const hist_ring_t *h, hist_level_t level)
+{
+    return h->count[level];
+}
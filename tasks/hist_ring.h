@@ -0,0 +1,69 @@
+#pragma once
+
+// 측정값 하나의 on-device history: 최근 raw 샘플 ring + 분/시간 단위 min/max/avg rollup ring.
+// 샘플 하나 추가는 O(1) (열린 분/시간 bucket 에 누적하다 경계를 넘으면 ring 에 밀어넣음). ESP-IDF 의존성 없음
+//
+// RAM: sizeof(hist_ring_t) = 64*8 + (60+24+2)*20 + 16 ≈ 2.2 KB / 측정값
+//      (raw 64개 = 10초 주기로 약 10분, minute 60개 = 1시간, hour 24개 = 하루)
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HIST_RAW_LEN    64
+#define HIST_MINUTE_LEN 60
+#define HIST_HOUR_LEN   24
+
+typedef struct {
+    float    value;
+    uint32_t t;       // 초 (wall_clock_now().t: unix time, SNTP 전에는 부팅 후 초)
+} hist_sample_t;
+
+typedef struct {
+    uint32_t start;   // bucket 시작 시각 (span 단위로 내림)
+    float    min;
+    float    max;
+    float    sum;
+    uint32_t count;   // 0이면 빈 bucket
+} hist_rollup_t;
+
+typedef enum {
+    HIST_LEVEL_MINUTE = 0,
+    HIST_LEVEL_HOUR,
+    HIST_LEVEL_COUNT,
+} hist_level_t;
+
+typedef struct {
+    hist_sample_t raw[HIST_RAW_LEN];
+    hist_rollup_t minute[HIST_MINUTE_LEN];
+    hist_rollup_t hour[HIST_HOUR_LEN];
+    hist_rollup_t open[HIST_LEVEL_COUNT];   // 아직 닫히지 않은 현재 분/시간
+    uint16_t      raw_head, raw_count;
+    uint16_t      head[HIST_LEVEL_COUNT];   // 다음에 쓸 위치
+    uint16_t      count[HIST_LEVEL_COUNT];
+    uint32_t      samples;                  // 누적 샘플 수
+} hist_ring_t;
+
+void hist_ring_init(hist_ring_t *h);
+
+// 샘플 추가. t가 열린 bucket 범위를 벗어나면 그 bucket을 닫아 ring에 넣고 새로 시작
+void hist_ring_add(hist_ring_t *h, float value, uint32_t t);
+
+// idx번째로 최근 raw 샘플 (0 = 최신), 없으면 NULL
+const hist_sample_t *hist_ring_sample(const hist_ring_t *h, int idx);
+
+// idx번째로 최근 닫힌 rollup (0 = 최신), 없으면 NULL. 현재 진행 중인 bucket은 h->open[level]
+const hist_rollup_t *hist_ring_rollup(const hist_ring_t *h, hist_level_t level, int idx);
+
+int hist_ring_rollup_count(const hist_ring_t *h, hist_level_t level);
+
+static inline float hist_rollup_avg(const hist_rollup_t *r)
+{
+    return r->count ? r->sum / (float)r->count : 0.0f;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,206 @@
+#include "history.h"
+#include "fb_keys.h"
+#include "wall_clock.h"
+#include "sdkconfig.h"
+#include <esp_log.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <stdio.h>
+#include <string.h>
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+static const char *TAG = "history";
+
+static const fb_key_t s_keys[HISTORY_COUNT] = {
+    FB_KEY_TEMPERATURE, FB_KEY_HUMIDITY, FB_KEY_SOIL_MOISTURE, FB_KEY_LIGHT_INTENSITY,
+};
+
+static_assert(HISTORY_COUNT <= 8, "history_upload_t::any / block series are uint8_t bit masks");
+
+static hist_ring_t s_rings[HISTORY_COUNT];
+static bool s_wall[HISTORY_COUNT];     // ring 의 시각이 벽시계 (false 면 부팅 후 초)
+static SemaphoreHandle_t s_lock;
+static StaticSemaphore_t s_lock_mem;
+
+void history_init(void)
+{
+    if (s_lock) return;
+    s_lock = xSemaphoreCreateMutexStatic(&s_lock_mem);
+    for (int i = 0; i < HISTORY_COUNT; i++) hist_ring_init(&s_rings[i]);
+    ESP_LOGI(TAG, "%d series, %u bytes", HISTORY_COUNT, (unsigned)sizeof(s_rings));
+}
+
+void history_record(history_id_t id, float value)
+{
+    if (!s_lock || id >= HISTORY_COUNT) return;
+    wall_stamp_t now = wall_clock_now();
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    if (now.wall && !s_wall[id]) {
+        // 부팅 후 초로 쌓은 bucket 은 벽시계 bucket 과 섞을 수 없음
+        hist_ring_init(&s_rings[id]);
+        s_wall[id] = true;
+    }
+    hist_ring_add(&s_rings[id], value, now.t);
+    xSemaphoreGive(s_lock);
+}
+
+// up 이후 가장 오래된 닫힌 시간 rollup (ring 은 0 = 최신), 없으면 NULL. lock 안에서
+static const hist_rollup_t *oldest_unsent(int i, const history_upload_t *up)
+{
+    if (!s_wall[i]) return NULL;
+    bool any = up->any & (1u << i);
+    for (int idx = hist_ring_rollup_count(&s_rings[i], HIST_LEVEL_HOUR) - 1; idx >= 0; idx--) {
+        const hist_rollup_t *r = hist_ring_rollup(&s_rings[i], HIST_LEVEL_HOUR, idx);
+        if (r->count && (!any || r->start > up->sent[i])) return r;
+    }
+    return NULL;
+}
+
+int history_encode_hour_block(const fb_encoder_t *enc, fb_buf_t *out, const history_upload_t *up,
+                              uint32_t *start, uint8_t *series)
+{
+    if (!s_lock) return 0;
+
+    hist_rollup_t hour[HISTORY_COUNT];
+    uint32_t oldest = 0;
+    bool found = false;
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    for (int i = 0; i < HISTORY_COUNT; i++) {
+        const hist_rollup_t *r = oldest_unsent(i, up);
+        hour[i] = r ? *r : hist_rollup_t{};
+        if (!r) continue;
+        if (!found || r->start < oldest) oldest = r->start;
+        found = true;
+    }
+    xSemaphoreGive(s_lock);
+    if (!found) return 0;
+
+    // 같은 시간의 rollup만 한 block에. 더 새 시간만 남은 측정값은 다음 block 에서
+    uint8_t mask = 0;
+    int n = 0;
+    for (int i = 0; i < HISTORY_COUNT; i++) {
+        if (hour[i].count && hour[i].start == oldest) {
+            mask |= (uint8_t)(1u << i);
+            n++;
+        }
+    }
+
+    fb_buf_reset(out);
+    enc->map_begin(out, (uint32_t)n);
+    for (int i = 0; i < HISTORY_COUNT; i++) {
+        if (!(mask & (1u << i))) continue;
+        const hist_rollup_t *r = &hour[i];
+        const fb_key_info_t &info = fb_key_info(s_keys[i]);
+        char name[32];
+        snprintf(name, sizeof(name), "%lu/%s", (unsigned long)oldest, info.name);
+        enc->key(out, name);
+        enc->map_begin(out, 4);
+        enc->key(out, "n");
+        enc->u32(out, r->count);
+        enc->key(out, "lo");
+        enc->f32(out, r->min, info.decimals);
+        enc->key(out, "hi");
+        enc->f32(out, r->max, info.decimals);
+        enc->key(out, "avg");
+        enc->f32(out, hist_rollup_avg(r), info.decimals);
+        enc->map_end(out);
+    }
+    enc->map_end(out);
+    enc->finish(out);
+
+    *start = oldest;
+    *series = mask;
+    return 1;
+}
+
+void history_hour_block_done(history_upload_t *up, uint32_t start, uint8_t series)
+{
+    for (int i = 0; i < HISTORY_COUNT; i++) {
+        if (!(series & (1u << i))) continue;
+        up->sent[i] = start;
+        up->any |= (uint8_t)(1u << i);
+    }
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+
+static void print_rollup(const char *label, const hist_rollup_t *r)
+{
+    printf("  %-7s %10lu  n=%-4lu min=%.2f max=%.2f avg=%.2f\n", label, (unsigned long)r->start,
+           (unsigned long)r->count, r->min, r->max, hist_rollup_avg(r));
+}
+
+// 콘솔 출력이 느려서 lock을 오래 잡지 않도록 복사해서 출력 (2 KB 남짓)
+static hist_ring_t s_print_copy;
+
+static void print_series(int id, const char *what)
+{
+    hist_ring_t &copy = s_print_copy;
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    copy = s_rings[id];
+    xSemaphoreGive(s_lock);
+
+    printf("%s: %lu samples\n", fb_key_info(s_keys[id]).name, (unsigned long)copy.samples);
+    if (!what) {
+        const hist_sample_t *s = hist_ring_sample(&copy, 0);
+        if (s) printf("  last    %10lu  %.2f\n", (unsigned long)s->t, s->value);
+        if (copy.open[HIST_LEVEL_MINUTE].count) print_rollup("minute", &copy.open[HIST_LEVEL_MINUTE]);
+        if (copy.open[HIST_LEVEL_HOUR].count) print_rollup("hour", &copy.open[HIST_LEVEL_HOUR]);
+        return;
+    }
+    if (strcmp(what, "raw") == 0) {
+        for (int i = copy.raw_count - 1; i >= 0; i--) {
+            const hist_sample_t *s = hist_ring_sample(&copy, i);
+            printf("  %10lu  %.2f\n", (unsigned long)s->t, s->value);
+        }
+        return;
+    }
+
+    hist_level_t level = (strcmp(what, "hour") == 0) ? HIST_LEVEL_HOUR : HIST_LEVEL_MINUTE;
+    const char *label = (level == HIST_LEVEL_HOUR) ? "hour" : "minute";
+    for (int i = hist_ring_rollup_count(&copy, level) - 1; i >= 0; i--) {
+        print_rollup(label, hist_ring_rollup(&copy, level, i));
+    }
+    if (copy.open[level].count) print_rollup("(open)", &copy.open[level]);
+}
+
+static esp_err_t history_cmd(int argc, char **argv)
+{
+    if (!s_lock) return ESP_ERR_INVALID_STATE;
+
+    if (argc == 0) {
+        for (int i = 0; i < HISTORY_COUNT; i++) print_series(i, NULL);
+        return ESP_OK;
+    }
+    for (int i = 0; i < HISTORY_COUNT; i++) {
+        if (strcmp(argv[0], fb_key_info(s_keys[i]).name) == 0) {
+            print_series(i, argc > 1 ? argv[1] : NULL);
+            return ESP_OK;
+        }
+    }
+    printf("usage: history [temperature|humidity|soilMoisture|lightIntensity] [raw|minute|hour]\n");
+    return ESP_ERR_INVALID_ARG;
+}
+
+void history_register_commands(void)
+{
+    static const esp_matter::console::command_t cmds[] = {
+        { "history", "On-device sensor history. Usage: history [name] [raw|minute|hour]", history_cmd },
+    };
+    esp_matter::console::add_commands(cmds, sizeof(cmds) / sizeof(cmds[0]));
+}
+
+#else
+
+void history_register_commands(void)
+{
+}
+
+#endif
+
+static_assert(sizeof(s_rings) + sizeof(s_wall) + sizeof(s_lock_mem) <= HISTORY_STATIC_BYTES,
+              "history.cpp statics outgrew HISTORY_STATIC_BYTES (history.h)");
@@ -0,0 +1,57 @@
+#pragma once
+
+// 측정값별 on-device history (hist_ring) 저장소 + console 조회 + 시간 단위 rollup 업로드용 인코딩
+
+#include <stddef.h>
+#include <stdint.h>
+#include "hist_ring.h"
+#include "fb_encoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 이름은 Firebase key와 같음
+typedef enum {
+    HISTORY_TEMPERATURE = 0,
+    HISTORY_HUMIDITY,
+    HISTORY_SOIL_MOISTURE,
+    HISTORY_LIGHT,
+    HISTORY_COUNT,
+} history_id_t;
+
+void history_init(void);
+
+// 샘플 하나 기록 (보고 정책과 상관없이 모든 샘플).
+// SNTP 전에는 부팅 후 초로 쌓다가 벽시계가 맞춰지면 그 측정값의 ring 을 비우고 unix time 으로 다시 시작
+void history_record(history_id_t id, float value);
+
+// 측정값별로 마지막으로 올린 시간 bucket. 센서마다 시간이 닫히는 시각이 다르고 업로드가 실패할 수 있어서
+// 하나의 "마지막으로 보낸 시각" 으로는 늦게 닫힌 측정값이나 실패한 옛 시간을 건너뜀
+typedef struct {
+    uint32_t sent[HISTORY_COUNT];   // 마지막으로 올린 bucket 시작 시각
+    uint8_t  any;                   // bit i: sent[i] 가 유효 (0 도 정상적인 시각이라 따로 둠)
+} history_upload_t;
+
+// 아직 올리지 않은 닫힌 시간 rollup 중 가장 오래된 시간 하나를, 그 시간이 닫혀 있는 측정값 전부에 대해
+// 하나의 block으로 인코딩. 벽시계로 쌓은 rollup 만 대상 (key 가 부팅마다 겹치지 않음).
+// 같은 시간이 나중에 닫힌 측정값은 다음 block 으로 가므로 key 는 경로 ("<start>/<name>") 로 써서
+// PATCH 가 먼저 올린 측정값을 덮지 않음
+// {"<start>/temperature":{"n":..,"lo":..,"hi":..,"avg":..},"<start>/humidity":{...},...}
+// 보낼 block이 없으면 0, 있으면 *start 에 그 시간, *series 에 담은 측정값 (bit i) 을 넣고 1
+int history_encode_hour_block(const fb_encoder_t *enc, fb_buf_t *out, const history_upload_t *up,
+                              uint32_t *start, uint8_t *series);
+
+// 위 block 이 올라갔음 (또는 버림): 담긴 측정값만 그 시간까지 진행
+void history_hour_block_done(history_upload_t *up, uint32_t start, uint8_t series);
+
+// "history [name] [raw|minute|hour]" console 명령 등록 (CONFIG_ENABLE_CHIP_SHELL일 때만)
+void history_register_commands(void);
+
+// 이 모듈의 정적 RAM 상한 (측정값별 ring, lock, 벽시계 flag). app_memory RAM map 용.
+// console 이 켜져 있으면 출력용 ring 복사본 sizeof(hist_ring_t) 가 더 있음 (RAM map 에 따로)
+#define HISTORY_STATIC_BYTES (HISTORY_COUNT * (sizeof(hist_ring_t) + 1) + sizeof(StaticSemaphore_t))
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,25 @@
+#include "lat_hist.h"
+
+uint32_t lat_hist_bucket_upper(const lat_hist_t *h, int b)
+{
+    if (b >= LAT_HIST_BUCKETS - 1) return h->max_us;
+    return (1u << b) - 1;
+}
+
+uint32_t lat_hist_percentile(const lat_hist_t *h, int pct)
+{
+    if (h->count == 0) return 0;
+
+    uint64_t target = ((uint64_t)h->count * pct + 99) / 100;
+    if (target == 0) target = 1;
+
+    uint64_t seen = 0;
+    for (int b = 0; b < LAT_HIST_BUCKETS; b++) {
+        seen += h->buckets[b];
+        if (seen >= target) {
+            uint32_t upper = lat_hist_bucket_upper(h, b);
+            return upper < h->max_us ? upper : h->max_us;
+        }
+    }
+    return h->max_us;
+}
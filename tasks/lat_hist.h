@@ -0,0 +1,43 @@
+#pragma once
+
+// 고정 bucket log2 latency histogram. bucket i = [2^(i-1), 2^i) us (bucket 0 = 0 us), 마지막 bucket은 그 이상 전부.
+// 추가 한 번이 clz 하나 + 카운터 몇 개라 계측 경로에 넣어도 부담 없음. ESP-IDF 의존성 없음
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LAT_HIST_BUCKETS 24   // 마지막 bucket >= 2^22 us (약 4.2 s)
+
+typedef struct {
+    uint32_t buckets[LAT_HIST_BUCKETS];
+    uint32_t count;
+    uint32_t max_us;
+    uint64_t sum_us;
+} lat_hist_t;
+
+static inline int lat_hist_bucket(uint32_t us)
+{
+    int b = us ? 32 - __builtin_clz(us) : 0;
+    return b < LAT_HIST_BUCKETS ? b : LAT_HIST_BUCKETS - 1;
+}
+
+static inline void lat_hist_add(lat_hist_t *h, uint32_t us)
+{
+    h->buckets[lat_hist_bucket(us)]++;
+    h->count++;
+    h->sum_us += us;
+    if (us > h->max_us) h->max_us = us;
+}
+
+// bucket b 의 상한 (us). 마지막 bucket은 max_us
+uint32_t lat_hist_bucket_upper(const lat_hist_t *h, int b);
+
+// pct (0~100) 백분위가 들어있는 bucket의 상한 (us). 비어 있으면 0
+uint32_t lat_hist_percentile(const lat_hist_t *h, int pct);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,136 @@
+#include "latency.h"
+#include "sdkconfig.h"
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <stdio.h>
+#include <string.h>
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+static const char *TAG = "latency";
+
+static const char *const s_stage_names[LAT_STAGE_COUNT] = {
+    "sample", "matter_hop", "queue_wait", "https",
+};
+
+static lat_hist_t s_hist[LAT_STAGE_COUNT];
+static portMUX_TYPE s_lat_mux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t s_overhead_ns;  // latency_record() 한 번 비용 (init 때 측정)
+static lat_hist_t s_scratch;    // 비용 측정용 (latency_init)
+
+static inline void record_into(lat_hist_t *h, int64_t us)
+{
+    uint32_t v = us < 0 ? 0 : (us > (int64_t)UINT32_MAX ? UINT32_MAX : (uint32_t)us);
+    portENTER_CRITICAL(&s_lat_mux);
+    lat_hist_add(h, v);
+    portEXIT_CRITICAL(&s_lat_mux);
+}
+
+void latency_init(void)
+{
+    // 실제 경로와 같은 lock + histogram 추가 비용을 scratch histogram으로 측정
+    const int n = 1000;
+    int64_t t0 = esp_timer_get_time();
+    for (int i = 0; i < n; i++) {
+        record_into(&s_scratch, esp_timer_get_time() - t0);
+    }
+    s_overhead_ns = (uint32_t)((esp_timer_get_time() - t0) * 1000 / n);
+    ESP_LOGI(TAG, "record overhead: %lu ns", (unsigned long)s_overhead_ns);
+}
+
+void latency_record(lat_stage_t stage, int64_t us)
+{
+    if (stage >= LAT_STAGE_COUNT) return;
+    record_into(&s_hist[stage], us);
+}
+
+static void snapshot(lat_hist_t out[LAT_STAGE_COUNT])
+{
+    portENTER_CRITICAL(&s_lat_mux);
+    memcpy(out, s_hist, sizeof(s_hist));
+    portEXIT_CRITICAL(&s_lat_mux);
+}
+
+void latency_get(lat_stage_t stage, lat_hist_t *out)
+{
+    if (stage >= LAT_STAGE_COUNT) return;
+    portENTER_CRITICAL(&s_lat_mux);
+    *out = s_hist[stage];
+    portEXIT_CRITICAL(&s_lat_mux);
+}
+
+void latency_dump(void)
+{
+    lat_hist_t h[LAT_STAGE_COUNT];
+    snapshot(h);
+
+    for (int s = 0; s < LAT_STAGE_COUNT; s++) {
+        if (h[s].count == 0) continue;
+        ESP_LOGI(TAG, "%-10s n=%lu avg=%lu p50<=%lu p90<=%lu p99<=%lu max=%lu us",
+                 s_stage_names[s], (unsigned long)h[s].count,
+                 (unsigned long)(h[s].sum_us / h[s].count),
+                 (unsigned long)lat_hist_percentile(&h[s], 50),
+                 (unsigned long)lat_hist_percentile(&h[s], 90),
+                 (unsigned long)lat_hist_percentile(&h[s], 99),
+                 (unsigned long)h[s].max_us);
+    }
+}
+
+void latency_report(void *ctx)
+{
+    latency_dump();
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+
+static esp_err_t latency_cmd(int argc, char **argv)
+{
+    if (argc > 0 && strcmp(argv[0], "reset") == 0) {
+        portENTER_CRITICAL(&s_lat_mux);
+        memset(s_hist, 0, sizeof(s_hist));
+        portEXIT_CRITICAL(&s_lat_mux);
+        printf("latency histograms cleared\n");
+        return ESP_OK;
+    }
+
+    lat_hist_t h[LAT_STAGE_COUNT];
+    snapshot(h);
+
+    printf("record overhead %lu ns\n", (unsigned long)s_overhead_ns);
+    for (int s = 0; s < LAT_STAGE_COUNT; s++) {
+        printf("%s: n=%lu", s_stage_names[s], (unsigned long)h[s].count);
+        if (h[s].count) {
+            printf(" avg=%lu max=%lu us", (unsigned long)(h[s].sum_us / h[s].count),
+                   (unsigned long)h[s].max_us);
+        }
+        printf("\n");
+        for (int b = 0; b < LAT_HIST_BUCKETS; b++) {
+            if (!h[s].buckets[b]) continue;
+            printf("  <=%8lu us  %lu\n", (unsigned long)lat_hist_bucket_upper(&h[s], b),
+                   (unsigned long)h[s].buckets[b]);
+        }
+    }
+    return ESP_OK;
+}
+
+void latency_register_commands(void)
+{
+    static const esp_matter::console::command_t cmds[] = {
+        { "latency", "Sensor-to-cloud latency histograms. Usage: latency [reset]", latency_cmd },
+    };
+    esp_matter::console::add_commands(cmds, sizeof(cmds) / sizeof(cmds[0]));
+}
+
+#else
+
+void latency_register_commands(void)
+{
+}
+
+#endif
+
+static_assert(sizeof(s_hist) + sizeof(s_overhead_ns) + sizeof(s_scratch) <= LATENCY_STATIC_BYTES,
+              "latency.cpp statics outgrew LATENCY_STATIC_BYTES (latency.h)");
@@ -0,0 +1,44 @@
+#pragma once
+
+// 센서 -> cloud 경로 단계별 latency histogram (esp_timer_get_time() 기준 us)
+
+#include <stddef.h>
+#include <stdint.h>
+#include "lat_hist.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    LAT_STAGE_SAMPLE = 0,   // 드라이버 읽기만 (dht_read_data / ADC burst 변환 합, burst 사이 대기 제외)
+    LAT_STAGE_MATTER_HOP,   // ScheduleLambda 요청 -> Matter 스레드에서 실행
+    LAT_STAGE_QUEUE_WAIT,   // fb_update()로 dirty 된 뒤 uploader가 가져갈 때까지
+    LAT_STAGE_HTTPS,        // esp_http_client_perform() 한 번
+    LAT_STAGE_COUNT,
+} lat_stage_t;
+
+// 기록 비용을 재서 로그로 남김 (app_main에서 한 번)
+void latency_init(void);
+
+// 어느 태스크에서든 호출 가능 (짧은 critical section)
+void latency_record(lat_stage_t stage, int64_t us);
+
+// 단계 하나의 histogram 복사본 (테스트 / 다른 모듈 보고용)
+void latency_get(lat_stage_t stage, lat_hist_t *out);
+
+// 단계별 count/avg/p50/p90/p99/max 로그 출력
+void latency_dump(void);
+
+// sensor scheduler 콜백: 주기적으로 latency_dump()
+void latency_report(void *ctx);
+
+// "latency [reset]" console 명령 등록 (CONFIG_ENABLE_CHIP_SHELL일 때만)
+void latency_register_commands(void);
+
+// 이 모듈의 정적 RAM 상한 (단계별 histogram + 비용 측정용 하나, overhead). app_memory RAM map 용
+#define LATENCY_STATIC_BYTES ((LAT_STAGE_COUNT + 1) * sizeof(lat_hist_t) + sizeof(uint32_t))
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,165 @@
+#include "matter_batch.h"
+#include "latency.h"
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <esp_matter.h>
+
+#include "freertos/FreeRTOS.h"
+
+using namespace esp_matter;
+
+static const char *TAG = "matter_batch";
+
+typedef struct {
+    uint16_t endpoint_id;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    esp_matter_attr_val_t val;  // bind 때 읽은 값 (타입/nullable 정보 유지), 이후 숫자만 바꿈
+    bool dirty;
+} matter_batch_slot_t;
+
+static matter_batch_slot_t s_slots[MATTER_BATCH_MAX];
+static int s_count;
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+static bool s_scheduled;    // lambda가 아직 실행 전
+static int64_t s_first_us;  // 이번 batch 첫 값 예약 시각 (matter hop latency)
+static matter_batch_stats_t s_stats;
+
+int matter_batch_bind(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id)
+{
+    if (s_count >= MATTER_BATCH_MAX) return -1;
+
+    attribute_t *attribute = attribute::get(endpoint_id, cluster_id, attribute_id);
+    if (!attribute) {
+        ESP_LOGE(TAG, "no attribute %lu/%lu on endpoint %u",
+                 (unsigned long)cluster_id, (unsigned long)attribute_id, endpoint_id);
+        return -1;
+    }
+
+    matter_batch_slot_t *slot = &s_slots[s_count];
+    slot->endpoint_id = endpoint_id;
+    slot->cluster_id = cluster_id;
+    slot->attribute_id = attribute_id;
+    slot->val = esp_matter_invalid(NULL);
+    attribute::get_val(attribute, &slot->val);
+    return s_count++;
+}
+
+static void stage(int handle, void (*write)(esp_matter_attr_val_t *, int32_t), int32_t value)
+{
+    if (handle < 0 || handle >= s_count) return;
+
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&s_mux);
+    matter_batch_slot_t *slot = &s_slots[handle];
+    write(&slot->val, value);
+    if (slot->dirty) s_stats.coalesced++;
+    slot->dirty = true;
+    if (!s_first_us) s_first_us = now;
+    portEXIT_CRITICAL(&s_mux);
+}
+
+static void write_i16(esp_matter_attr_val_t *val, int32_t v)
+{
+    val->val.i16 = (int16_t)v;
+}
+
+static void write_u16(esp_matter_attr_val_t *val, int32_t v)
+{
+    val->val.u16 = (uint16_t)v;
+}
+
+void matter_batch_set_i16(int handle, int16_t value)
+{
+    stage(handle, write_i16, value);
+}
+
+void matter_batch_set_u16(int handle, uint16_t value)
+{
+    stage(handle, write_u16, value);
+}
+
+/* Matter 스레드: 예약된 값을 한 번에 꺼내서 적용 */
+static void apply_pending(void)
+{
+    matter_batch_slot_t pending[MATTER_BATCH_MAX];
+    int n = 0;
+    int64_t t0 = esp_timer_get_time();
+
+    portENTER_CRITICAL(&s_mux);
+    for (int i = 0; i < s_count; i++) {
+        if (!s_slots[i].dirty) continue;
+        pending[n++] = s_slots[i];
+        s_slots[i].dirty = false;
+    }
+    int64_t first_us = s_first_us;
+    s_first_us = 0;
+    s_scheduled = false;
+    portEXIT_CRITICAL(&s_mux);
+
+    if (first_us) latency_record(LAT_STAGE_MATTER_HOP, t0 - first_us);
+
+    for (int i = 0; i < n; i++) {
+        attribute::update(pending[i].endpoint_id, pending[i].cluster_id, pending[i].attribute_id, &pending[i].val);
+    }
+
+    uint32_t us = (uint32_t)(esp_timer_get_time() - t0);
+    portENTER_CRITICAL(&s_mux);
+    s_stats.values += n;
+    s_stats.total_us += us;
+    if (us > s_stats.max_us) s_stats.max_us = us;
+    portEXIT_CRITICAL(&s_mux);
+}
+
+void matter_batch_flush(void)
+{
+    bool any = false;
+
+    portENTER_CRITICAL(&s_mux);
+    if (!s_scheduled) {
+        for (int i = 0; i < s_count && !any; i++) any = s_slots[i].dirty;
+        if (any) s_scheduled = true;
+    }
+    portEXIT_CRITICAL(&s_mux);
+
+    // 이미 예약된 lambda가 있으면 거기서 같이 적용됨
+    if (!any) return;
+    CHIP_ERROR err = chip::DeviceLayer::SystemLayer().ScheduleLambda([]() { apply_pending(); });
+
+    portENTER_CRITICAL(&s_mux);
+    if (err == CHIP_NO_ERROR) {
+        s_stats.flushes++;
+    } else {
+        // 예약이 안 됐으면 s_scheduled 를 풀어야 다음 flush 가 다시 시도함 (값은 dirty 로 남아있음)
+        s_scheduled = false;
+        s_stats.sched_errors++;
+    }
+    portEXIT_CRITICAL(&s_mux);
+
+    if (err != CHIP_NO_ERROR) {
+        ESP_LOGW(TAG, "ScheduleLambda failed: %" CHIP_ERROR_FORMAT ", retrying next round", err.Format());
+    }
+}
+
+void matter_batch_get_stats(matter_batch_stats_t *out)
+{
+    portENTER_CRITICAL(&s_mux);
+    *out = s_stats;
+    portEXIT_CRITICAL(&s_mux);
+}
+
+void matter_batch_report(void *ctx)
+{
+    matter_batch_stats_t st;
+    matter_batch_get_stats(&st);
+    if (st.flushes == 0) return;
+
+    ESP_LOGI(TAG, "wakeups=%lu (unbatched would be %lu) coalesced=%lu avg=%lu us max=%lu us per wakeup, sched errors=%lu",
+             (unsigned long)st.flushes, (unsigned long)(st.values + st.coalesced),
+             (unsigned long)st.coalesced, (unsigned long)(st.total_us / st.flushes),
+             (unsigned long)st.max_us, (unsigned long)st.sched_errors);
+}
+
+static_assert(sizeof(s_slots) + sizeof(s_count) + sizeof(s_scheduled) + sizeof(s_first_us) + sizeof(s_stats) <=
+              MATTER_BATCH_STATIC_BYTES,
+              "matter_batch.cpp statics outgrew MATTER_BATCH_STATIC_BYTES (matter_batch.h)");
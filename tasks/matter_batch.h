@@ -0,0 +1,44 @@
+#pragma once
+
+// 센서 측정값 Matter 속성 갱신 batch: 한 샘플링 라운드의 값을 모아 ScheduleLambda 한 번으로 적용.
+// 속성은 endpoint 만든 뒤 한 번 bind 해서 handle(인덱스)로 씀
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MATTER_BATCH_MAX 8
+
+typedef struct {
+    uint32_t flushes;      // Matter 스레드를 깨운 횟수 (ScheduleLambda)
+    uint32_t values;       // 적용한 속성 값 수 (batch 전에는 이만큼 깨웠음)
+    uint32_t coalesced;    // 적용 전에 새 값으로 덮어쓴 횟수
+    uint64_t total_us;     // Matter 스레드에서 적용에 쓴 시간 합
+    uint32_t max_us;       // 한 번 적용 최대 시간
+    uint32_t sched_errors; // ScheduleLambda 실패 (값은 남겨두고 다음 라운드에 다시)
+} matter_batch_stats_t;
+
+// endpoint 생성 뒤 (Matter start 전후 상관없음) 속성 하나 등록. 실패하면 -1
+int matter_batch_bind(uint16_t endpoint_id, uint32_t cluster_id, uint32_t attribute_id);
+
+// 값 예약 (어느 태스크에서든). 같은 handle에 다시 쓰면 마지막 값만 적용
+void matter_batch_set_i16(int handle, int16_t value);
+void matter_batch_set_u16(int handle, uint16_t value);
+
+// 예약된 값이 있으면 Matter 스레드에 한 번 넘김 (sensor scheduler가 라운드마다 호출)
+void matter_batch_flush(void);
+
+void matter_batch_get_stats(matter_batch_stats_t *out);
+
+// sensor scheduler 콜백: wakeup 수 / 라운드당 시간 로그
+void matter_batch_report(void *ctx);
+
+// 이 모듈의 정적 RAM 상한 (속성 슬롯 하나 48 byte 이하, 통계 / 상태 64 byte). app_memory RAM map 용
+#define MATTER_BATCH_STATIC_BYTES (MATTER_BATCH_MAX * 48 + 64)
+
+#ifdef __cplusplus
+}
+#endif
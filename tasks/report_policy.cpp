@@ -0,0 +1,43 @@
+#include "report_policy.h"
+#include <math.h>
+
+static bool value_changed(const report_policy_t *policy, float last, float value)
+{
+    float delta = fabsf(value - last);
+
+    // 두 deadband 중 넓은 쪽: 상대 deadband가 큰 값에서 band를 넓히고, 0 근처에서는 abs deadband가 하한
+    float band = policy->abs_deadband > 0 ? policy->abs_deadband : 0;
+    if (policy->rel_deadband > 0 && policy->rel_deadband * fabsf(last) > band) {
+        band = policy->rel_deadband * fabsf(last);
+    }
+    return delta > 0 && delta >= band;
+}
+
+bool report_policy_check(const report_policy_t *policy, report_state_t *state,
+                         float value, uint64_t now_ms)
+{
+    bool emit;
+
+    if (!state->reported) {
+        emit = true;
+    } else {
+        uint64_t elapsed = now_ms - state->last_ms;
+        if (elapsed < policy->min_interval_ms) {
+            emit = false;
+        } else if (policy->max_interval_ms && elapsed >= policy->max_interval_ms) {
+            emit = true;
+        } else {
+            emit = value_changed(policy, state->last_value, value);
+        }
+    }
+
+    if (emit) {
+        state->last_value = value;
+        state->last_ms = now_ms;
+        state->reported = true;
+        state->emitted++;
+    } else {
+        state->suppressed++;
+    }
+    return emit;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+// 측정값 보고 정책 (deadband + 최소/최대 보고 간격).
+// Matter/Firebase로 보내기 전에 걸러서 값이 그대로면 아무것도 보내지 않음. ESP-IDF 의존성 없음
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    float    abs_deadband;     // 직전 보고 값보다 이만큼 이상 바뀌면 보고 (0이면 사용 안 함)
+    float    rel_deadband;     // 직전 보고 값 대비 비율 (0.1 = 10%, 0이면 사용 안 함). 둘 다 있으면 넓은 쪽
+    uint32_t min_interval_ms;  // 이보다 자주 보고하지 않음
+    uint32_t max_interval_ms;  // 변화가 없어도 이 간격마다 한 번은 보고 (0이면 없음)
+} report_policy_t;
+
+typedef struct {
+    float    last_value;   // 마지막으로 보고한 값
+    uint64_t last_ms;
+    bool     reported;     // 한 번이라도 보고했는지
+    uint32_t emitted;
+    uint32_t suppressed;
+} report_state_t;
+
+// value를 보고해야 하면 true (state 갱신). deadband 둘 다 0이면 값이 조금이라도 바뀌면 보고.
+// 변화 기준은 max(abs_deadband, rel_deadband * |직전 보고 값|)
+bool report_policy_check(const report_policy_t *policy, report_state_t *state,
+                         float value, uint64_t now_ms);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,78 @@
+#include "sched_heap.h"
+
+static inline uint64_t due_of(const sched_heap_t *s, int pos)
+{
+    return s->entries[s->heap[pos]].due_ms;
+}
+
+static inline void swap_pos(sched_heap_t *s, int a, int b)
+{
+    uint8_t t = s->heap[a];
+    s->heap[a] = s->heap[b];
+    s->heap[b] = t;
+}
+
+static void sift_up(sched_heap_t *s, int pos)
+{
+    while (pos > 0) {
+        int parent = (pos - 1) / 2;
+        if (due_of(s, parent) <= due_of(s, pos)) break;
+        swap_pos(s, parent, pos);
+        pos = parent;
+    }
+}
+
+static void sift_down(sched_heap_t *s, int pos)
+{
+    for (;;) {
+        int l = 2 * pos + 1, r = l + 1, min = pos;
+        if (l < s->count && due_of(s, l) < due_of(s, min)) min = l;
+        if (r < s->count && due_of(s, r) < due_of(s, min)) min = r;
+        if (min == pos) break;
+        swap_pos(s, pos, min);
+        pos = min;
+    }
+}
+
+int sched_heap_add(sched_heap_t *s, const char *name, sched_fn_t fn, void *ctx,
+                   uint32_t period_ms, uint64_t first_due_ms)
+{
+    if (s->count >= SCHED_MAX_ENTRIES || period_ms == 0) return -1;
+
+    int idx = s->count;
+    sched_entry_t *e = &s->entries[idx];
+    *e = {};
+    e->name = name;
+    e->fn = fn;
+    e->ctx = ctx;
+    e->period_ms = period_ms;
+    e->due_ms = first_due_ms;
+
+    s->heap[s->count++] = (uint8_t)idx;
+    sift_up(s, s->count - 1);
+    return idx;
+}
+
+sched_entry_t *sched_heap_pop_due(sched_heap_t *s, uint64_t now_ms)
+{
+    if (s->count == 0 || due_of(s, 0) > now_ms) return nullptr;
+
+    sched_entry_t *e = &s->entries[s->heap[0]];
+    uint64_t late = now_ms - e->due_ms;
+    e->last_late_ms = (uint32_t)late;
+    if (e->last_late_ms > e->max_late_ms) e->max_late_ms = e->last_late_ms;
+    e->runs++;
+
+    // 한 주기 이상 밀렸으면 놓친 주기는 몰아서 돌리지 않고 건너뜀
+    uint64_t missed = late / e->period_ms;
+    e->skipped += (uint32_t)missed;
+    e->due_ms += (missed + 1) * e->period_ms;
+
+    sift_down(s, 0);
+    return e;
+}
+
+uint64_t sched_heap_next_due(const sched_heap_t *s)
+{
+    return s->count ? due_of(s, 0) : UINT64_MAX;
+}
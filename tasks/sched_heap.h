@@ -0,0 +1,47 @@
+#pragma once
+
+// 센서 스케줄러 코어: 다음 실행 시각(due) 기준 min-heap.
+// 시각은 호출자가 넘겨주는 ms 값이라 (가상 시계로) host에서 drift/jitter 검증 가능
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SCHED_MAX_ENTRIES 12   // 센서 3 + 보고/진단 항목, 여유 몇 칸
+
+typedef void (*sched_fn_t)(void *ctx);
+
+typedef struct {
+    const char *name;
+    sched_fn_t  fn;
+    void       *ctx;
+    uint32_t    period_ms;
+    uint64_t    due_ms;       // 다음 실행 예정 시각
+    uint32_t    runs;
+    uint32_t    last_late_ms; // 이번 실행이 예정보다 늦은 시간
+    uint32_t    max_late_ms;  // jitter 최대값
+    uint32_t    skipped;      // 너무 밀려서 건너뛴 주기 수
+} sched_entry_t;
+
+typedef struct {
+    sched_entry_t entries[SCHED_MAX_ENTRIES];
+    uint8_t       heap[SCHED_MAX_ENTRIES];  // entries 인덱스, heap[0]이 가장 먼저 due
+    uint8_t       count;
+} sched_heap_t;
+
+// 항목 추가. 꽉 찼으면 -1, 아니면 entries 인덱스
+int sched_heap_add(sched_heap_t *s, const char *name, sched_fn_t fn, void *ctx,
+                   uint32_t period_ms, uint64_t first_due_ms);
+
+// now_ms 에 due 된 항목이 있으면 다음 주기로 옮기고 반환 (실행은 호출자), 없으면 NULL.
+// 다음 due 는 이전 due + period 라서 실행 시간이 쌓여도 drift 없음.
+sched_entry_t *sched_heap_pop_due(sched_heap_t *s, uint64_t now_ms);
+
+// 가장 빠른 due 시각 (항목 없으면 UINT64_MAX)
+uint64_t sched_heap_next_due(const sched_heap_t *s);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,38 @@
+#include "sensor_bus.h"
+#include <string.h>
+
+int sensor_bus_subscribe(sensor_bus_t *bus, const sensor_sub_cfg_t *cfg)
+{
+    if (bus->count >= SENSOR_BUS_MAX_SUBS || !cfg->fn) return -1;
+
+    sensor_sub_t *s = &bus->subs[bus->count];
+    memset(s, 0, sizeof(*s));
+    s->cfg = *cfg;
+    return bus->count++;
+}
+
+int sensor_bus_publish(sensor_bus_t *bus, sensor_reading_t *r)
+{
+    if ((unsigned)r->key >= FB_KEY_COUNT) return 0;
+
+    r->seq = ++bus->seq;
+    const uint32_t bit = SENSOR_KEY_BIT(r->key);
+    int delivered = 0;
+
+    for (int i = 0; i < bus->count; i++) {
+        sensor_sub_t *s = &bus->subs[i];
+        if (s->cfg.key_mask && !(s->cfg.key_mask & bit)) {
+            s->filtered++;
+            continue;
+        }
+        if (s->cfg.policies &&
+            !report_policy_check(&s->cfg.policies[r->key], &s->state[r->key], r->value, r->t_ms)) {
+            s->limited++;
+            continue;
+        }
+        s->cfg.fn(r, s->cfg.ctx);
+        s->delivered++;
+        delivered++;
+    }
+    return delivered;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+// in-process 센서 bus. producer는 측정값 record 하나를 publish하고, 구독한 sink들은
+// 자기 key filter + key별 보고 정책(deadband / 간격)을 통과한 record를 같은 포인터로 받음 (복사/heap 할당 없음).
+// ESP-IDF 의존성 없음. 구독은 시작 전에, publish는 한 태스크(sensor scheduler)에서만
+
+#include <stdint.h>
+#include "fb_keys.h"
+#include "report_policy.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SENSOR_BUS_MAX_SUBS 6
+
+#define SENSOR_KEY_BIT(key) (1u << (key))
+static_assert(FB_KEY_COUNT <= 32, "key filter is a 32-bit mask");
+
+typedef struct {
+    fb_key_t key;
+    uint16_t endpoint_id;  // 측정한 Matter endpoint (0이면 없음)
+    float    value;        // 변환된 값 (°C, %, lux ...)
+    uint64_t t_ms;         // 측정 시각
+    uint32_t seq;          // publish 순번 (bus가 매김)
+} sensor_reading_t;
+
+typedef void (*sensor_sink_fn_t)(const sensor_reading_t *r, void *ctx);
+
+typedef struct {
+    const char            *name;
+    sensor_sink_fn_t       fn;
+    void                  *ctx;
+    uint32_t               key_mask;  // SENSOR_KEY_BIT()들, 0이면 전부
+    const report_policy_t *policies;  // [FB_KEY_COUNT], NULL이면 filter를 통과한 모든 샘플 전달
+} sensor_sub_cfg_t;
+
+typedef struct {
+    sensor_sub_cfg_t cfg;
+    report_state_t   state[FB_KEY_COUNT];  // policies가 있을 때 key별 상태
+    uint32_t         delivered;
+    uint32_t         filtered;   // key_mask에 없음
+    uint32_t         limited;    // 보고 정책에 걸림
+} sensor_sub_t;
+
+typedef struct {
+    sensor_sub_t subs[SENSOR_BUS_MAX_SUBS];
+    uint8_t      count;
+    uint32_t     seq;
+} sensor_bus_t;
+
+// 구독 추가 (cfg는 복사). 꽉 찼으면 -1, 아니면 구독 번호
+int sensor_bus_subscribe(sensor_bus_t *bus, const sensor_sub_cfg_t *cfg);
+
+// r->seq를 매기고 구독 순서대로 전달. 받은 sink 수 반환
+int sensor_bus_publish(sensor_bus_t *bus, sensor_reading_t *r);
+
+// producer 쪽 진입점: 앱이 구현 (측정 시각을 찍어서 앱의 bus로 publish)
+void sensor_publish(fb_key_t key, uint16_t endpoint_id, float value);
+
+#ifdef __cplusplus
+}
+#endif
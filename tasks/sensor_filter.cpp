@@ -0,0 +1,28 @@
+#include "sensor_filter.h"
+
+float sensor_filter_median(float *v, int n)
+{
+    // n <= SENSOR_FILTER_MAX_MEDIAN 라서 insertion sort로 충분
+    for (int i = 1; i < n; i++) {
+        float x = v[i];
+        int j = i - 1;
+        while (j >= 0 && v[j] > x) {
+            v[j + 1] = v[j];
+            j--;
+        }
+        v[j + 1] = x;
+    }
+    if (n % 2) return v[n / 2];
+    return (v[n / 2 - 1] + v[n / 2]) * 0.5f;
+}
+
+float sensor_filter_ema(sensor_filter_t *state, float alpha, float x)
+{
+    if (!state->primed) {
+        state->ema = x;
+        state->primed = true;
+    } else {
+        state->ema += alpha * (x - state->ema);
+    }
+    return state->ema;
+}
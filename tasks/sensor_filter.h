@@ -0,0 +1,34 @@
+#pragma once
+
+// 아날로그 센서 필터: mains 한 주기 burst 평균 -> median-of-N -> EMA
+// 커널은 ESP-IDF 의존성 없는 순수 함수 (host에서 노이즈 주입/벤치마크 가능)
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SENSOR_FILTER_MAX_MEDIAN 9
+
+typedef struct {
+    uint8_t  median_n;      // burst 개수 (홀수 권장, 1이면 median 없음)
+    uint16_t burst_gap_ms;  // burst 사이 간격 (모터 노이즈 같은 순간 spike를 한 burst에만 걸리게)
+    float    ema_alpha;     // 0 < alpha <= 1, 1이면 EMA 없음
+} sensor_filter_cfg_t;
+
+typedef struct {
+    float ema;
+    bool  primed;  // 첫 값은 EMA 없이 그대로 사용
+} sensor_filter_t;
+
+// v[0..n) 의 중앙값 (v는 정렬됨)
+float sensor_filter_median(float *v, int n);
+
+// EMA 한 단계 적용 후 결과 반환
+float sensor_filter_ema(sensor_filter_t *state, float alpha, float x);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,115 @@
+#include "sensor_sched.h"
+#include "app_memory_config.h"
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <stdio.h>
+#include "sdkconfig.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#if CONFIG_ENABLE_CHIP_SHELL
+#include <esp_matter_console.h>
+#endif
+
+static const char *TAG = "sensor_sched";
+
+static sched_heap_t s_sched;
+static void (*s_round_hook)(void);
+
+static inline uint64_t now_ms(void)
+{
+    return (uint64_t)(esp_timer_get_time() / 1000);
+}
+
+int sensor_sched_register(const char *name, sched_fn_t fn, void *ctx, uint32_t period_ms)
+{
+    // 처음엔 모두 바로 실행 -> 같은 주기끼리 정렬돼서 Firebase batch에 같이 들어감
+    int idx = sched_heap_add(&s_sched, name, fn, ctx, period_ms, now_ms());
+    if (idx < 0) {
+        ESP_LOGE(TAG, "cannot register %s", name);
+    }
+    return idx;
+}
+
+void sensor_sched_set_round_hook(void (*hook)(void))
+{
+    s_round_hook = hook;
+}
+
+static void sensor_sched_task(void *pv)
+{
+    for (;;) {
+        sched_entry_t *e;
+        int ran = 0;
+        while ((e = sched_heap_pop_due(&s_sched, now_ms())) != NULL) {
+            e->fn(e->ctx);
+            ran++;
+        }
+        if (ran && s_round_hook) s_round_hook();
+
+        uint64_t next = sched_heap_next_due(&s_sched);
+        uint64_t now = now_ms();
+        TickType_t wait = (next > now) ? pdMS_TO_TICKS(next - now) : 0;
+        vTaskDelay(wait > 0 ? wait : 1);
+    }
+}
+
+static StackType_t s_stack[APP_SENSOR_SCHED_STACK];
+static StaticTask_t s_tcb;
+
+void sensor_sched_start(void)
+{
+    xTaskCreateStatic(sensor_sched_task, "sensor_sched", APP_SENSOR_SCHED_STACK, NULL,
+                      APP_SENSOR_SCHED_PRIO, s_stack, &s_tcb);
+}
+
+static_assert(sizeof(s_sched) + sizeof(s_round_hook) + sizeof(s_stack) + sizeof(s_tcb) <= SENSOR_SCHED_STATIC_BYTES,
+              "sensor_sched.cpp statics outgrew SENSOR_SCHED_STATIC_BYTES (sensor_sched.h)");
+
+void sensor_sched_dump(void)
+{
+    for (int i = 0; i < s_sched.count; i++) {
+        const sched_entry_t *e = &s_sched.entries[i];
+        ESP_LOGI(TAG, "%-12s period=%lu ms runs=%lu late=%lu ms max_late=%lu ms skipped=%lu",
+                 e->name, (unsigned long)e->period_ms, (unsigned long)e->runs,
+                 (unsigned long)e->last_late_ms, (unsigned long)e->max_late_ms, (unsigned long)e->skipped);
+    }
+}
+
+void sensor_sched_report(void *ctx)
+{
+    sensor_sched_dump();
+}
+
+#if CONFIG_ENABLE_CHIP_SHELL
+
+static esp_err_t sched_cmd(int argc, char **argv)
+{
+    uint64_t now = now_ms();
+    printf("%d/%d entries\n", s_sched.count, SCHED_MAX_ENTRIES);
+    for (int i = 0; i < s_sched.count; i++) {
+        const sched_entry_t *e = &s_sched.entries[i];
+        printf("%-14s period=%lu ms next in %ld ms runs=%lu late=%lu max_late=%lu ms skipped=%lu\n",
+               e->name, (unsigned long)e->period_ms, (long)((int64_t)e->due_ms - (int64_t)now),
+               (unsigned long)e->runs, (unsigned long)e->last_late_ms, (unsigned long)e->max_late_ms,
+               (unsigned long)e->skipped);
+    }
+    return ESP_OK;
+}
+
+void sensor_sched_register_commands(void)
+{
+    static const esp_matter::console::command_t cmds[] = {
+        { "sched", "Sensor scheduler entries, runs and lateness", sched_cmd },
+    };
+    esp_matter::console::add_commands(cmds, sizeof(cmds) / sizeof(cmds[0]));
+}
+
+#else
+
+void sensor_sched_register_commands(void)
+{
+}
+
+#endif
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "app_memory_config.h"
+#include "sched_heap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 센서 샘플 콜백 등록 (sensor_sched_start() 전에 호출). 모든 센서가 같은 태스크에서 period_ms마다 실행됨
+int sensor_sched_register(const char *name, sched_fn_t fn, void *ctx, uint32_t period_ms);
+
+// due 된 콜백들을 다 실행한 뒤(라운드 끝)마다 한 번 호출할 함수 (예: Matter 속성 batch flush)
+void sensor_sched_set_round_hook(void (*hook)(void));
+
+// 스케줄러 태스크 시작 (app_main에서 한 번)
+void sensor_sched_start(void);
+
+// 등록된 센서별 실행 횟수/지연(jitter) 로그 출력
+void sensor_sched_dump(void);
+
+// sensor scheduler 콜백: 주기적으로 sensor_sched_dump()
+void sensor_sched_report(void *ctx);
+
+// "sched" console 명령 등록 (CONFIG_ENABLE_CHIP_SHELL일 때만)
+void sensor_sched_register_commands(void);
+
+// 이 모듈의 정적 RAM 상한 (stack/TCB, schedule heap + 16 byte). app_memory RAM map 용
+#define SENSOR_SCHED_STATIC_BYTES (APP_TASK_BYTES(APP_SENSOR_SCHED_STACK) + sizeof(sched_heap_t) + 16)
+
+#ifdef __cplusplus
+}
+#endif
@@ -5,9 +5,7 @@
 extern "C" {
 #endif
 
-void humidity_sensor_notification(uint16_t endpoint_id, float humidity, void *user_data);
-
-void soil_moisture_task(void *ep);
+void soil_moisture_sample(void *ep);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,161 @@
+#include "sse_parser.h"
+#include <string.h>
+
+void sse_parser_init(sse_parser_t *p, sse_event_cb_t cb, void *ctx)
+{
+    memset(p, 0, sizeof(*p));
+    p->cb = cb;
+    p->ctx = ctx;
+}
+
+static void clear_event(sse_parser_t *p)
+{
+    p->event[0] = '\0';
+    p->data_ref = NULL;
+    p->data_len = 0;
+    p->has_data = false;
+    p->data_overflow = false;
+}
+
+void sse_parser_reset(sse_parser_t *p)
+{
+    p->line_len = 0;
+    p->line_overflow = false;
+    p->skip_lf = false;
+    clear_event(p);
+}
+
+/* data를 p->data로 옮김 (chunk가 사라지기 전이나 줄을 이어 붙여야 할 때) */
+static void own_data(sse_parser_t *p)
+{
+    if (!p->has_data || p->data_ref == p->data) return;
+    memmove(p->data, p->data_ref, p->data_len);
+    p->data_ref = p->data;
+}
+
+static void append_data(sse_parser_t *p, const char *val, size_t len, bool in_chunk)
+{
+    if (p->data_overflow) return;
+    if (len > SSE_DATA_MAX) {
+        // chunk 안의 줄은 SSE_LINE_MAX 보다 길 수 있음: 나중에 data[] 로 옮길 수 없으니 여기서 버림
+        p->data_overflow = true;
+        return;
+    }
+
+    if (!p->has_data && in_chunk) {
+        // 첫 data 줄이 chunk 안에 있으면 가리키기만 함
+        p->data_ref = val;
+        p->data_len = len;
+        p->has_data = true;
+        return;
+    }
+
+    own_data(p);
+    size_t need = p->data_len + (p->has_data ? 1 : 0) + len;
+    if (need > SSE_DATA_MAX) {
+        p->data_overflow = true;
+        return;
+    }
+    if (p->has_data) p->data[p->data_len++] = '\n';
+    memcpy(p->data + p->data_len, val, len);
+    p->data_len += len;
+    p->data_ref = p->data;
+    p->has_data = true;
+}
+
+static void dispatch(sse_parser_t *p)
+{
+    if (p->data_overflow) {
+        p->dropped++;
+    } else if (p->has_data) {
+        p->events++;
+        p->cb(p->ctx, p->event[0] ? p->event : "message", p->data_ref, p->data_len);
+    }
+    clear_event(p);
+}
+
+static void process_line(sse_parser_t *p, const char *line, size_t len, bool in_chunk)
+{
+    if (len == 0) {
+        dispatch(p);
+        return;
+    }
+    if (line[0] == ':') return;  // comment (keep-alive)
+
+    const char *colon = (const char *)memchr(line, ':', len);
+    size_t name_len = colon ? (size_t)(colon - line) : len;
+    const char *val = colon ? colon + 1 : line + len;
+    size_t val_len = len - (size_t)(val - line);
+    if (val_len && *val == ' ') {
+        val++;
+        val_len--;
+    }
+
+    if (name_len == 4 && memcmp(line, "data", 4) == 0) {
+        append_data(p, val, val_len, in_chunk);
+    } else if (name_len == 5 && memcmp(line, "event", 5) == 0) {
+        size_t n = val_len < SSE_EVENT_MAX - 1 ? val_len : SSE_EVENT_MAX - 1;
+        memcpy(p->event, val, n);
+        p->event[n] = '\0';
+    }
+    // id, retry 는 쓰지 않음
+}
+
+void sse_parser_feed(sse_parser_t *p, const char *buf, size_t len)
+{
+    const char *end = buf + len;
+    const char *s = buf;
+
+    if (p->skip_lf && s < end) {
+        if (*s == '\n') s++;
+        p->skip_lf = false;
+    }
+
+    while (s < end) {
+        const char *nl = s;
+        while (nl < end && *nl != '\n' && *nl != '\r') nl++;
+
+        if (nl == end) {
+            // 미완성 줄: 다음 chunk까지 보관
+            size_t n = (size_t)(end - s);
+            if (p->line_overflow || p->line_len + n > SSE_LINE_MAX) {
+                if (!p->line_overflow) p->dropped++;
+                p->line_overflow = true;
+            } else {
+                memcpy(p->line + p->line_len, s, n);
+                p->line_len += n;
+            }
+            break;
+        }
+
+        if (p->line_overflow) {
+            p->line_overflow = false;
+            p->line_len = 0;
+        } else if (p->line_len) {
+            // 이전 chunk에서 시작한 줄: 나머지를 이어 붙여서 처리
+            size_t n = (size_t)(nl - s);
+            if (p->line_len + n > SSE_LINE_MAX) {
+                p->dropped++;
+            } else {
+                memcpy(p->line + p->line_len, s, n);
+                process_line(p, p->line, p->line_len + n, false);
+            }
+            p->line_len = 0;
+        } else {
+            process_line(p, s, (size_t)(nl - s), true);
+        }
+
+        // CRLF / CR / LF 모두 줄 끝
+        if (*nl == '\r') {
+            if (nl + 1 < end) {
+                if (nl[1] == '\n') nl++;
+            } else {
+                p->skip_lf = true;
+            }
+        }
+        s = nl + 1;
+    }
+
+    // 이벤트가 아직 안 끝났는데 data가 chunk를 가리키고 있으면 복사해 둠
+    own_data(p);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+// text/event-stream (SSE) 증분 파서. 임의 크기 chunk를 넣으면 빈 줄마다 (event, data) 콜백.
+// chunk 안에서 끝나는 줄은 그 자리에서 처리하고, 한 줄짜리 data가 같은 chunk에서 이벤트까지 끝나면
+// chunk를 가리키는 포인터 그대로 넘김 (복사 없음). chunk 경계에 걸친 줄/data만 고정 버퍼로 복사. ESP-IDF 의존성 없음
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSE_LINE_MAX  512   // chunk 경계에 걸친 줄 하나 최대 길이
+#define SSE_DATA_MAX  512   // 이벤트 하나의 data 최대 길이 (넘치면 그 이벤트는 버림)
+#define SSE_EVENT_MAX 24
+
+// data는 NUL 종료 아님 (data_len 사용). 콜백 안에서만 유효
+typedef void (*sse_event_cb_t)(void *ctx, const char *event, const char *data, size_t data_len);
+
+typedef struct {
+    sse_event_cb_t cb;
+    void          *ctx;
+
+    char   line[SSE_LINE_MAX];   // 이전 chunk에서 넘어온 미완성 줄
+    size_t line_len;
+    bool   line_overflow;        // 지금 줄이 너무 길어서 버리는 중
+    bool   skip_lf;              // 직전 chunk가 '\r'로 끝남: 다음 '\n'은 같은 줄 끝
+
+    char        event[SSE_EVENT_MAX];
+    char        data[SSE_DATA_MAX];
+    const char *data_ref;        // 현재 data (chunk 안 또는 data[])
+    size_t      data_len;
+    bool        has_data;
+    bool        data_overflow;
+
+    uint32_t events;             // 콜백한 이벤트 수
+    uint32_t dropped;            // 너무 길어서 버린 줄/이벤트 수
+} sse_parser_t;
+
+void sse_parser_init(sse_parser_t *p, sse_event_cb_t cb, void *ctx);
+
+// 연결이 바뀌면 진행 중이던 줄/이벤트 버림 (통계는 유지)
+void sse_parser_reset(sse_parser_t *p);
+
+void sse_parser_feed(sse_parser_t *p, const char *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
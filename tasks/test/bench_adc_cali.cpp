@@ -0,0 +1,54 @@
+// raw -> mV: 부팅 때 만든 테이블 (adc_raw_to_mv) vs 샘플마다 adc_cali_raw_to_voltage().
+// 보정 드라이버는 host 모델 (shims/adc_cali_shim.cpp)이라 절대값보다 호출 경로 차이를 보는 용도
+#include "host_check.h"
+#include "adc_shared.h"
+#include <esp_adc/adc_cali.h>
+#include <esp_adc/adc_cali_scheme.h>
+
+static uint16_t s_lut[ADC_RAW_MAX + 1];
+
+int main()
+{
+    adc_cali_handle_t cali;
+    adc_cali_line_fitting_config_t cfg = {
+        .unit_id = ADC_UNIT_1,
+        .atten = ADC_SENSOR_ATTEN,
+        .bitwidth = ADC_BITWIDTH_12,
+    };
+    CHECK_EQ(adc_cali_create_scheme_line_fitting(&cfg, &cali), ESP_OK);
+
+    // adc_cali_build_lut()와 같은 방법으로 테이블 생성
+    for (int raw = 0; raw <= ADC_RAW_MAX; raw++) {
+        int mv = 0;
+        CHECK_EQ(adc_cali_raw_to_voltage(cali, raw, &mv), ESP_OK);
+        s_lut[raw] = (uint16_t)mv;
+    }
+    adc_mv_lut[ADC_SENSOR_ATTEN] = s_lut;
+
+    // 테이블은 드라이버 결과와 전 범위에서 같고, 범위 밖 입력은 clamp (float 평균값은 반올림)
+    for (int raw = 0; raw <= ADC_RAW_MAX; raw++) {
+        int mv = 0;
+        adc_cali_raw_to_voltage(cali, raw, &mv);
+        CHECK_EQ(adc_raw_to_mv(ADC_SENSOR_ATTEN, (float)raw), mv);
+    }
+    CHECK_EQ(adc_raw_to_mv(ADC_SENSOR_ATTEN, -3.0f), s_lut[0]);
+    CHECK_EQ(adc_raw_to_mv(ADC_SENSOR_ATTEN, 5000.0f), s_lut[ADC_RAW_MAX]);
+    CHECK_EQ(adc_raw_to_mv(ADC_SENSOR_ATTEN, 1000.6f), s_lut[1001]);
+
+    // 샘플 하나씩 (전 범위를 고르게)
+    const long iters = 4000000;
+    volatile int sink = 0;
+    double cali_ns = host_bench_ns(iters, [&](long i) {
+        int mv;
+        adc_cali_raw_to_voltage(cali, (int)(i & ADC_RAW_MAX), &mv);
+        sink = sink + mv;
+    });
+    double lut_ns = host_bench_ns(iters, [&](long i) {
+        sink = sink + adc_raw_to_mv(ADC_SENSOR_ATTEN, (float)(i & ADC_RAW_MAX));
+    });
+    printf("raw->mV per sample: adc_cali_raw_to_voltage %.2f ns, lut %.2f ns (%.1fx)\n",
+           cali_ns, lut_ns, cali_ns / lut_ns);
+
+    adc_cali_delete_scheme_line_fitting(cali);
+    return host_check_result("bench_adc_cali");
+}
@@ -0,0 +1,26 @@
+// fb_update() 한 번 (센서 태스크 쪽 enqueue 경로: slot 갱신 + lane pending 집계 + uploader 깨우기) 비용.
+// uploader 는 돌리지 않으므로 slot 은 계속 dirty (덮어쓰기 경로)
+#include "host_check.h"
+#include "firebase.h"
+#include "fb_keys.h"
+
+int main()
+{
+    fb_queue_init();
+
+    const fb_key_t sensors[] = { FB_KEY_TEMPERATURE, FB_KEY_HUMIDITY, FB_KEY_SOIL_MOISTURE, FB_KEY_LIGHT_INTENSITY };
+    double update_ns = host_bench_ns(2000000, [&](long i) { fb_update(sensors[i & 3], (float)(i & 1023)); });
+    double find_ns = host_bench_ns(2000000, [&](long i) {
+        volatile fb_key_t k = fb_key_find(fb_key_table[i % FB_KEY_COUNT].name);
+        (void)k;
+    });
+
+    fb_metrics_t m;
+    fb_get_metrics(&m);
+    CHECK_EQ(m.updates, 2000000u);
+    CHECK_EQ(m.drops, 0u);
+    CHECK_EQ(m.pending_hwm[FB_LANE_SENSOR], 4);
+
+    printf("fb_update %.1f ns/call (enum key), fb_key_find by name %.1f ns\n", update_ns, find_ns);
+    return host_check_result("bench_fb_enqueue");
+}
@@ -0,0 +1,55 @@
+// sensor_publish() 한 번 비용: 앱과 같은 sink 3개 (history 전부 / matter 측정값 key + 정책 / firebase 정책).
+// 보고 정책에 거의 다 걸리는 경우 (값 그대로) 와 매번 전부 전달되는 경우, sink 가 없는 bus 기준값
+#include "host_check.h"
+#include "sensor_bus.h"
+
+static volatile float s_sink_acc;
+
+static void sink(const sensor_reading_t *r, void *ctx)
+{
+    s_sink_acc = s_sink_acc + r->value;
+}
+
+int main()
+{
+    static sensor_bus_t empty, bus;
+    static report_policy_t policies[FB_KEY_COUNT];
+    for (int k = 0; k < FB_KEY_COUNT; k++) policies[k] = { 0.5f, 0.02f, 0, 10 * 60 * 1000 };
+
+    const uint32_t measure = SENSOR_KEY_BIT(FB_KEY_TEMPERATURE) | SENSOR_KEY_BIT(FB_KEY_HUMIDITY) |
+                             SENSOR_KEY_BIT(FB_KEY_SOIL_MOISTURE) | SENSOR_KEY_BIT(FB_KEY_LIGHT_INTENSITY);
+    const sensor_sub_cfg_t subs[] = {
+        { "history", sink, NULL, 0, NULL },
+        { "matter", sink, NULL, measure, policies },
+        { "firebase", sink, NULL, 0, policies },
+    };
+    for (const sensor_sub_cfg_t &s : subs) CHECK(sensor_bus_subscribe(&bus, &s) >= 0);
+
+    const fb_key_t keys[] = { FB_KEY_TEMPERATURE, FB_KEY_HUMIDITY, FB_KEY_SOIL_MOISTURE, FB_KEY_LIGHT_INTENSITY };
+    const long iters = 2000000;
+
+    double empty_ns = host_bench_ns(iters, [&](long i) {
+        sensor_reading_t r = { keys[i & 3], 3, 20.0f, (uint64_t)i, 0 };
+        sensor_bus_publish(&empty, &r);
+    });
+    // 값 그대로: history 만 받고 matter / firebase 는 정책에 걸림 (시각은 max interval 안에서만 흐름)
+    double steady_ns = host_bench_ns(iters, [&](long i) {
+        sensor_reading_t r = { keys[i & 3], 3, 20.0f, (uint64_t)(i / 1000), 0 };
+        sensor_bus_publish(&bus, &r);
+    });
+    uint32_t limited = bus.subs[1].limited + bus.subs[2].limited;
+    // 매번 deadband 밖: 세 sink 모두
+    double changing_ns = host_bench_ns(iters, [&](long i) {
+        sensor_reading_t r = { keys[i & 3], 3, (i & 4) ? 20.0f : 30.0f, (uint64_t)(iters + i), 0 };
+        sensor_bus_publish(&bus, &r);
+    });
+
+    CHECK_EQ(bus.subs[0].delivered, 2u * iters);
+    CHECK_EQ(limited, 2u * (iters - 4));  // key 마다 첫 값만 보고
+    CHECK_EQ(bus.subs[1].limited + bus.subs[2].limited, limited);  // 두 번째 구간은 전부 전달
+
+    printf("sensor_bus_publish %.1f ns (no sinks), %.1f ns (3 sinks, policy-limited), %.1f ns (3 sinks, all delivered), "
+           "sizeof(sensor_bus_t) %u\n",
+           empty_ns, steady_ns, changing_ns, (unsigned)sizeof(sensor_bus_t));
+    return host_check_result("bench_sensor_bus");
+}
@@ -0,0 +1,76 @@
+// adc_ring: 합성 TYPE1 DMA 프레임 -> 채널별 ring 분배, 최근 n개 평균 / 복사, ring wrap
+#include "host_check.h"
+#include "adc_ring.h"
+#include <string.h>
+
+// TYPE1 word: data[11:0], channel[15:12] (little endian)
+static size_t put_word(uint8_t *frame, size_t at, int channel, uint16_t raw)
+{
+    uint16_t w = (uint16_t)((channel << 12) | (raw & 0x0FFF));
+    frame[at] = (uint8_t)w;
+    frame[at + 1] = (uint8_t)(w >> 8);
+    return at + 2;
+}
+
+static adc_ring_t s_rings[2];
+
+int main()
+{
+    int8_t ring_of_channel[ADC_RING_MAX_CH];
+    memset(ring_of_channel, -1, sizeof(ring_of_channel));
+    ring_of_channel[6] = 0;  // CDS
+    ring_of_channel[7] = 1;  // soil
+
+    // 6/7 교대 + 등록 안 된 채널 3 하나 + 끝에 남는 1 byte
+    uint8_t frame[64];
+    size_t len = 0;
+    for (int i = 0; i < 10; i++) {
+        len = put_word(frame, len, 6, (uint16_t)(100 + i));
+        len = put_word(frame, len, 7, (uint16_t)(4000 + i));
+    }
+    len = put_word(frame, len, 3, 1234);
+    frame[len++] = 0xAB;
+
+    CHECK_EQ(adc_demux_type1(frame, len, s_rings, ring_of_channel), 20);
+    CHECK_EQ(s_rings[0].count, 10);
+    CHECK_EQ(s_rings[1].count, 10);
+    CHECK_EQ(s_rings[0].total, 10);
+
+    float avg = -1;
+    CHECK_EQ(adc_ring_average(&s_rings[0], 10, &avg), 10);
+    CHECK_NEAR(avg, 104.5, 1e-6);
+    CHECK_EQ(adc_ring_average(&s_rings[1], 4, &avg), 4);   // 최근 4개: 4006..4009
+    CHECK_NEAR(avg, 4007.5, 1e-6);
+    CHECK_EQ(adc_ring_average(&s_rings[1], 50, &avg), 10); // 있는 만큼만
+
+    uint16_t out[ADC_RING_LEN];
+    CHECK_EQ(adc_ring_copy_latest(&s_rings[0], 3, out), 3);
+    CHECK_EQ(out[0], 107);
+    CHECK_EQ(out[2], 109);
+
+    // 12 bit 값은 그대로 (채널 bit가 섞이지 않음)
+    len = put_word(frame, 0, 6, 0x0FFF);
+    CHECK_EQ(adc_demux_type1(frame, len, s_rings, ring_of_channel), 1);
+    CHECK_EQ(adc_ring_copy_latest(&s_rings[0], 1, out), 1);
+    CHECK_EQ(out[0], 0x0FFF);
+
+    // ring이 돌아도 최근 ADC_RING_LEN개만, 오래된 것부터
+    adc_ring_t ring = {};
+    for (int i = 0; i < ADC_RING_LEN + 37; i++) adc_ring_push(&ring, (uint16_t)i);
+    CHECK_EQ(ring.count, ADC_RING_LEN);
+    CHECK_EQ(ring.total, ADC_RING_LEN + 37);
+    CHECK_EQ(adc_ring_copy_latest(&ring, ADC_RING_LEN, out), ADC_RING_LEN);
+    CHECK_EQ(out[0], 37);
+    CHECK_EQ(out[ADC_RING_LEN - 1], ADC_RING_LEN + 36);
+    CHECK_EQ(adc_ring_average(&ring, 2, &avg), 2);
+    CHECK_NEAR(avg, ADC_RING_LEN + 35.5, 1e-6);
+
+    // 빈 ring / n <= 0: 0을 돌려주고 avg는 건드리지 않음
+    adc_ring_t empty = {};
+    avg = -7;
+    CHECK_EQ(adc_ring_average(&empty, 8, &avg), 0);
+    CHECK_EQ(adc_ring_average(&ring, 0, &avg), 0);
+    CHECK_NEAR(avg, -7, 0);
+
+    return host_check_result("test_adc_ring");
+}
@@ -0,0 +1,42 @@
+// cds_mv_to_lux_fast() 테이블을 기준 식 cds_mv_to_lux() 와 0..3299 mV 전부 비교 + 범위 밖 clamp + 비용
+#include "host_check.h"
+#include "sensor_convert.h"
+
+int main()
+{
+    // 허용 오차: 0.01 lux 양자화 반 칸 + float 반올림 (0.0078), 큰 값에서는 float ulp 하나
+    double max_abs = 0;
+    int worst_mv = -1;
+    for (int mv = 0; mv < CDS_LUX_TABLE_LEN; mv++) {
+        double ref = cds_mv_to_lux(mv);
+        double lut = cds_mv_to_lux_fast(mv);
+        double err = fabs(lut - ref);
+        // float 결과라 큰 값(가장 밝은 쪽, ~4e6 lux)에서는 float ulp(0.25~0.5)가 오차의 하한
+        double ulp = nextafterf((float)ref, INFINITY) - (float)ref;
+        if (err > max_abs && err > ulp) {
+            max_abs = err;
+            worst_mv = mv;
+        }
+        CHECK(err <= 0.0078 + ulp);
+    }
+    printf("max |err| %.4f lux at %d mV (outside float ulp)\n", max_abs, worst_mv);
+
+    // 단조 감소 (밝을수록 CdS 저항이 작아져 분압 전압이 낮음)
+    for (int mv = 1; mv < CDS_LUX_TABLE_LEN; mv++) {
+        CHECK(cds_lux_table.centi_lux[mv] <= cds_lux_table.centi_lux[mv - 1]);
+    }
+
+    // 범위 밖: 음수는 0 mV (최대 밝기), Vin 이상은 마지막 값 (가장 어두움)
+    CHECK_EQ(cds_mv_to_lux_fast(-5), cds_mv_to_lux_fast(0));
+    CHECK_EQ(cds_mv_to_lux_fast(3300), cds_mv_to_lux_fast(CDS_LUX_TABLE_LEN - 1));
+    CHECK_EQ(cds_mv_to_lux_fast(4095), cds_mv_to_lux_fast(CDS_LUX_TABLE_LEN - 1));
+    CHECK(cds_mv_to_lux_fast(3300) < 1.0f);
+
+    // 변환 한 번 비용: pow() 기준 식 vs 테이블
+    volatile float sink = 0;
+    double pow_ns = host_bench_ns(300000, [&](long i) { sink = sink + cds_mv_to_lux((int)(i % 3300)); });
+    double lut_ns = host_bench_ns(300000, [&](long i) { sink = sink + cds_mv_to_lux_fast((int)(i % 3300)); });
+    printf("cds_mv_to_lux %.1f ns, cds_mv_to_lux_fast %.1f ns\n", pow_ns, lut_ns);
+
+    return host_check_result("test_cds_lux_table");
+}
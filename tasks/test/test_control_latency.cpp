@@ -0,0 +1,96 @@
+// control lane 지연: sensor batch 가 쉬지 않고 나가는 동안 (요청 하나 LATENCY_MS) control 값이
+// 진행 중인 요청 하나만 기다리고 바로 따로 나가는지 확인. 부하 없을 때와 있을 때 fb_update -> perform 시작 시간을 출력
+#include "host_check.h"
+#include "host_shims.h"
+#include "firebase.h"
+#include <esp_timer.h>
+#include <atomic>
+#include <string.h>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#define LATENCY_MS  50
+#define SAMPLES     20
+#define SPACING_MS  (LATENCY_MS * 3)  // control 값끼리 한 요청으로 합쳐지지 않을 만큼 (+ 요청 안의 여러 위치)
+
+static const fb_key_t s_sensor_keys[] = {
+    FB_KEY_TEMPERATURE, FB_KEY_HUMIDITY, FB_KEY_SOIL_MOISTURE, FB_KEY_LIGHT_INTENSITY,
+    FB_KEY_HEAP_MIN_FREE, FB_KEY_HEAP_LARGEST_BLOCK, FB_KEY_HEAP_FRAG_PCT, FB_KEY_STACK_FREE_UPLOADER,
+};
+
+// ledStatus 가 든 요청들의 perform 시작 시각 (from 번째 요청부터)
+static std::vector<int64_t> control_requests(int from, int *data_requests)
+{
+    std::vector<int64_t> out;
+    *data_requests = 0;
+    for (int i = from; i < host_http_request_count(); i++) {
+        host_http_req_t req;
+        if (!host_http_get_request(i, &req)) continue;
+        if (strstr(req.body, "\"ledStatus\":")) {
+            // control lane 은 sensor key 와 섞이지 않음
+            CHECK(strstr(req.body, "\"temperature\"") == NULL);
+            out.push_back(req.at_us);
+        } else if (strstr(req.url, "/plant_data.json")) {
+            (*data_requests)++;
+        }
+    }
+    return out;
+}
+
+// control 값 SAMPLES 개를 SPACING_MS 간격으로 넣고 각각 요청이 시작될 때까지 걸린 시간 (us)
+static std::vector<int64_t> measure(int *data_requests)
+{
+    int from = host_http_request_count();
+    std::vector<int64_t> queued;
+    for (int i = 0; i < SAMPLES; i++) {
+        queued.push_back(esp_timer_get_time());
+        fb_update(FB_KEY_LED_STATUS, (float)(i & 1));
+        std::this_thread::sleep_for(std::chrono::milliseconds(SPACING_MS + i * 7 % LATENCY_MS));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(LATENCY_MS * 4));
+
+    std::vector<int64_t> sent = control_requests(from, data_requests);
+    CHECK_EQ(sent.size(), (size_t)SAMPLES);
+    std::vector<int64_t> wait;
+    for (size_t i = 0; i < sent.size() && i < queued.size(); i++) wait.push_back(sent[i] - queued[i]);
+    std::sort(wait.begin(), wait.end());
+    return wait;
+}
+
+int main()
+{
+    host_dns_set("smart-plant-app-1-default-rtdb.asia-southeast1.firebasedatabase.app", "10.0.0.7");
+    host_http_set_latency_ms(LATENCY_MS);
+    fb_queue_init();
+    firebase_uploader_start();
+
+    // 부하 없음: 보낼 것이 없으니 control 값은 바로 나감
+    int data_requests = 0;
+    std::vector<int64_t> idle = measure(&data_requests);
+    CHECK(!idle.empty() && idle.back() < LATENCY_MS * 1000);
+
+    // 부하: sensor key 8개 (= max_keys) 를 5 ms 마다 -> batch 가 window 없이 연달아 나감
+    std::atomic<bool> stop{ false };
+    std::thread load([&] {
+        for (float v = 0; !stop; v += 1) {
+            for (fb_key_t key : s_sensor_keys) fb_update(key, v);
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    });
+    std::vector<int64_t> busy = measure(&data_requests);
+    stop = true;
+    load.join();
+
+    // uploader 가 쉬지 않았어야 의미가 있음: control 값 하나마다 sensor batch 가 여러 개
+    CHECK(data_requests >= SAMPLES * 2);
+    // 진행 중인 sensor 요청 하나 (LATENCY_MS) 만 기다림. sensor batch 뒤에 rollup / diagnostics 가
+    // 줄줄이 붙으면 2~3 요청을 기다리게 됨
+    CHECK(!busy.empty() && busy.back() < 2 * LATENCY_MS * 1000);
+
+    printf("control wait (us) idle p50=%lld max=%lld, under load (%d sensor batches) p50=%lld max=%lld\n",
+           (long long)idle[idle.size() / 2], (long long)idle.back(), data_requests,
+           (long long)busy[busy.size() / 2], (long long)busy.back());
+
+    return host_check_result("test_control_latency");
+}
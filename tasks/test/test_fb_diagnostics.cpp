@@ -0,0 +1,68 @@
+// 실패 status code 집계: code 마다 칸 하나, 칸 (FB_METRICS_STATUS_SLOTS) 이 다 찬 뒤의 새 code 는
+// 마지막 칸에 섞지 않고 "other" 로 따로 세서 diagnostics 에 싣는지 확인. 재시도 대기 / 주기는 가상 esp_timer 로
+#include "host_check.h"
+#include "host_shims.h"
+#include "firebase.h"
+#include "sdkconfig.h"
+#include <string.h>
+#include <thread>
+
+#define HOST "smart-plant-app-1-default-rtdb.asia-southeast1.firebasedatabase.app"
+
+static bool wait_failures(uint32_t n)
+{
+    for (int i = 0; i < 3000; i++) {
+        fb_metrics_t m;
+        fb_get_metrics(&m);
+        if (m.http_failures >= n) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+int main()
+{
+    host_timer_set_virtual(1000000);
+    host_dns_set(HOST, "10.0.0.7");
+    fb_queue_init();
+    firebase_uploader_start();
+
+    // 서로 다른 code 8개 + 처음 것 한 번 더. 실패 뒤 재시도 대기 (FB_RETRY_MS) 는 가상 시계로 넘김
+    const int statuses[] = { 400, 401, 403, 404, 429, 500, 502, 503, 400 };
+    const int n = (int)(sizeof(statuses) / sizeof(statuses[0]));
+    for (int i = 0; i < n; i++) {
+        host_http_push_result(ESP_OK, statuses[i]);
+        host_timer_advance_us(3000000);
+        fb_update(FB_KEY_LED_STATUS, (float)(i & 1));
+        CHECK(wait_failures((uint32_t)i + 1));
+    }
+
+    fb_metrics_t m;
+    fb_get_metrics(&m);
+    CHECK_EQ(m.http_failures, (uint32_t)n);
+    CHECK_EQ(FB_METRICS_STATUS_SLOTS, 6);
+    const int kept[] = { 400, 401, 403, 404, 429, 500 };
+    for (int i = 0; i < FB_METRICS_STATUS_SLOTS; i++) CHECK_EQ(m.fail_status[i], kept[i]);
+    CHECK_EQ(m.fail_count[0], 2u);
+    CHECK_EQ(m.fail_count[5], 1u);   // 500 에 502 / 503 이 섞이지 않음
+    CHECK_EQ(m.fail_other, 2u);
+
+    // diagnostics 주기가 지나면 다음 한가한 틈에 "other" 와 함께
+    host_timer_advance_us((int64_t)CONFIG_FB_DIAGNOSTICS_INTERVAL_S * 1000000);
+    int from = host_http_request_count();
+    fb_update(FB_KEY_LED_STATUS, 1);
+    bool found = false;
+    for (int t = 0; t < 3000 && !found; t++) {
+        for (int i = from; i < host_http_request_count() && !found; i++) {
+            host_http_req_t req;
+            if (!host_http_get_request(i, &req) || !strstr(req.url, "/diagnostics")) continue;
+            found = true;
+            CHECK(strstr(req.body, "\"httpFailures\":{\"400\":2,\"401\":1,\"403\":1,\"404\":1,\"429\":1,"
+                                   "\"500\":1,\"other\":2}") != NULL);
+        }
+        if (!found) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK(found);
+
+    return host_check_result("test_fb_diagnostics");
+}
@@ -0,0 +1,72 @@
+// fb_dns: TTL 동안은 캐시, TTL 이 지나면 다시 조회, invalidate 뒤 다시 조회, 조회 실패, 다른 host,
+// 작은 출력 버퍼. 시간은 가상 시계로만 흐름
+#include "host_check.h"
+#include "host_shims.h"
+#include "fb_dns.h"
+#include "sdkconfig.h"
+
+#define HOST  "smart-plant-app-1-default-rtdb.asia-southeast1.firebasedatabase.app"
+#define TTL_US ((int64_t)CONFIG_FB_DNS_CACHE_TTL_S * 1000000)
+
+int main()
+{
+    host_timer_set_virtual(1000000);
+    host_dns_set(HOST, "10.0.0.7");
+
+    // 첫 조회는 resolver 로
+    char ip[16];
+    CHECK(fb_dns_resolve(HOST, ip, sizeof(ip)));
+    CHECK_STR(ip, "10.0.0.7");
+    CHECK_EQ(host_dns_lookups(), 1u);
+
+    // TTL 안: resolver 주소가 바뀌어도 캐시한 주소
+    host_dns_set(HOST, "10.0.0.8");
+    host_timer_advance_us(TTL_US - 1);
+    CHECK(fb_dns_resolve(HOST, ip, sizeof(ip)));
+    CHECK_STR(ip, "10.0.0.7");
+    CHECK_EQ(host_dns_lookups(), 1u);
+
+    // TTL 이 지나면 다시 조회
+    host_timer_advance_us(1);
+    CHECK(fb_dns_resolve(HOST, ip, sizeof(ip)));
+    CHECK_STR(ip, "10.0.0.8");
+    CHECK_EQ(host_dns_lookups(), 2u);
+
+    // 연결 실패 -> invalidate: TTL 안이어도 다시 조회
+    host_dns_set(HOST, "10.0.0.9");
+    fb_dns_invalidate();
+    CHECK(fb_dns_resolve(HOST, ip, sizeof(ip)));
+    CHECK_STR(ip, "10.0.0.9");
+    CHECK_EQ(host_dns_lookups(), 3u);
+
+    // 다른 host 는 캐시를 쓰지 않음 (resolver 는 HOST 만 알아서 실패)
+    CHECK(!fb_dns_resolve("example.com", ip, sizeof(ip)));
+    CHECK_EQ(host_dns_lookups(), 4u);
+    // 실패해도 원래 host 의 캐시는 그대로
+    CHECK(fb_dns_resolve(HOST, ip, sizeof(ip)));
+    CHECK_STR(ip, "10.0.0.9");
+    CHECK_EQ(host_dns_lookups(), 4u);
+
+    // 조회 실패: false, 실패할 때마다 다시 조회 (실패는 캐시하지 않음)
+    fb_dns_invalidate();
+    host_dns_set(HOST, NULL);
+    CHECK(!fb_dns_resolve(HOST, ip, sizeof(ip)));
+    CHECK(!fb_dns_resolve(HOST, ip, sizeof(ip)));
+    CHECK_EQ(host_dns_lookups(), 6u);
+    host_dns_set(HOST, "10.0.0.10");
+    CHECK(fb_dns_resolve(HOST, ip, sizeof(ip)));
+    CHECK_STR(ip, "10.0.0.10");
+
+    // 출력 버퍼가 작으면 잘라서 NUL 로 끝냄
+    char small[6];
+    CHECK(fb_dns_resolve(HOST, small, sizeof(small)));
+    CHECK_STR(small, "10.0.");
+
+    fb_dns_stats_t st;
+    fb_dns_get_stats(&st);
+    CHECK_EQ(st.misses, 7u);
+    CHECK_EQ(st.failures, 3u);
+    CHECK_EQ(st.hits, 3u);
+
+    return host_check_result("test_fb_dns");
+}
@@ -0,0 +1,186 @@
+// fb_encoder: JSON / CBOR 출력 byte 를 그대로 비교 (중첩 map 의 ',' , 소수 반올림, CBOR head 길이 경계,
+// float 비트), 버퍼 넘침 표시. 센서 batch 하나 인코딩 비용도 출력
+#include "host_check.h"
+#include "fb_encoder.h"
+#include <math.h>
+#include <string.h>
+#include <vector>
+
+static std::vector<uint8_t> bytes(const fb_buf_t &b)
+{
+    return std::vector<uint8_t>(b.data, b.data + b.len);
+}
+
+#define CHECK_BYTES(buf, ...)                                               \
+    do {                                                                    \
+        const std::vector<uint8_t> want_ = { __VA_ARGS__ };                 \
+        CHECK_EQ((buf).len, want_.size());                                  \
+        CHECK(bytes(buf) == want_);                                         \
+    } while (0)
+
+// plant_data batch 와 같은 모양: {"temperature":23.46,"ledStatus":true,"n":42}
+static void encode_batch(const fb_encoder_t *enc, fb_buf_t *b)
+{
+    fb_buf_reset(b);
+    enc->map_begin(b, 3);
+    enc->key(b, "temperature");
+    enc->f32(b, 23.456f, 2);
+    enc->key(b, "ledStatus");
+    enc->boolean(b, true);
+    enc->key(b, "n");
+    enc->u32(b, 42);
+    enc->map_end(b);
+    enc->finish(b);
+}
+
+static const char *json_f32(float v, uint8_t decimals)
+{
+    static uint8_t mem[32];
+    fb_buf_t b;
+    fb_buf_init(&b, mem, sizeof(mem));
+    fb_json_encoder.f32(&b, v, decimals);
+    fb_json_encoder.finish(&b);
+    return (const char *)mem;
+}
+
+int main()
+{
+    uint8_t mem[256];
+    fb_buf_t b;
+    fb_buf_init(&b, mem, sizeof(mem));
+
+    // JSON: 정확한 문자열, NUL 은 len 에 안 들어감
+    {
+        encode_batch(&fb_json_encoder, &b);
+        CHECK_STR((const char *)mem, "{\"temperature\":23.46,\"ledStatus\":true,\"n\":42}");
+        CHECK_EQ(b.len, strlen((const char *)mem));
+        CHECK(!b.overflow);
+        CHECK_EQ(b.depth, 0);
+    }
+
+    // 중첩 map: 깊이마다 첫 key 앞에는 ',' 없음
+    {
+        const fb_encoder_t *e = &fb_json_encoder;
+        fb_buf_reset(&b);
+        e->map_begin(&b, 2);
+        e->key(&b, "3600");
+        e->map_begin(&b, 2);
+        e->key(&b, "temperature");
+        e->map_begin(&b, 2);
+        e->key(&b, "n");
+        e->u32(&b, 360);
+        e->key(&b, "lo");
+        e->f32(&b, -1.5f, 1);
+        e->map_end(&b);
+        e->key(&b, "humidity");
+        e->map_begin(&b, 0);
+        e->map_end(&b);
+        e->map_end(&b);
+        e->key(&b, "s");
+        e->str(&b, "ok");
+        e->map_end(&b);
+        e->finish(&b);
+        CHECK_STR((const char *)mem, "{\"3600\":{\"temperature\":{\"n\":360,\"lo\":-1.5},\"humidity\":{}},\"s\":\"ok\"}");
+    }
+
+    // 숫자: half-up 반올림, 자리수 0..6 (7 이상은 6), 음수, 비유한값은 null, u32 전 범위
+    CHECK_STR(json_f32(23.456f, 2), "23.46");
+    CHECK_STR(json_f32(0.5f, 0), "1");
+    CHECK_STR(json_f32(2.0f, 3), "2.000");
+    CHECK_STR(json_f32(0.05f, 1), "0.1");
+    CHECK_STR(json_f32(-12.25f, 1), "-12.3");
+    CHECK_STR(json_f32(0.001f, 2), "0.00");
+    CHECK_STR(json_f32(1.0f / 3, 9), "0.333333");
+    CHECK_STR(json_f32(4194304.0f, 2), "4194304.00");
+    CHECK_STR(json_f32(NAN, 2), "null");
+    CHECK_STR(json_f32(-INFINITY, 2), "null");
+    {
+        fb_buf_reset(&b);
+        fb_json_encoder.u32(&b, 0);
+        fb_json_encoder.boolean(&b, false);
+        fb_json_encoder.u32(&b, UINT32_MAX);
+        fb_json_encoder.finish(&b);
+        CHECK_STR((const char *)mem, "0false4294967295");
+    }
+
+    // CBOR: 같은 batch -> A3 6B "temperature" FA <23.456f> 69 "ledStatus" F5 61 "n" 18 2A
+    {
+        encode_batch(&fb_cbor_encoder, &b);
+        CHECK_BYTES(b, 0xA3,
+                    0x6B, 't', 'e', 'm', 'p', 'e', 'r', 'a', 't', 'u', 'r', 'e', 0xFA, 0x41, 0xBB, 0xA5, 0xE3,
+                    0x69, 'l', 'e', 'd', 'S', 't', 'a', 't', 'u', 's', 0xF5,
+                    0x61, 'n', 0x18, 0x2A);
+    }
+
+    // CBOR head 길이 경계 (RFC 8949 부록 A 예제와 같은 값)
+    {
+        const fb_encoder_t *e = &fb_cbor_encoder;
+        fb_buf_reset(&b);
+        e->u32(&b, 0);
+        e->u32(&b, 23);
+        e->u32(&b, 24);
+        e->u32(&b, 255);
+        e->u32(&b, 256);
+        e->u32(&b, 65535);
+        e->u32(&b, 65536);
+        e->u32(&b, 1000000);
+        CHECK_BYTES(b, 0x00, 0x17, 0x18, 0x18, 0x18, 0xFF, 0x19, 0x01, 0x00, 0x19, 0xFF, 0xFF,
+                    0x1A, 0x00, 0x01, 0x00, 0x00, 0x1A, 0x00, 0x0F, 0x42, 0x40);
+
+        fb_buf_reset(&b);
+        e->f32(&b, 1.5f, 2);
+        e->f32(&b, -4.0f, 2);
+        e->f32(&b, 100000.0f, 0);
+        e->boolean(&b, false);
+        e->map_begin(&b, 0);
+        e->map_end(&b);
+        e->map_begin(&b, 24);
+        CHECK_BYTES(b, 0xFA, 0x3F, 0xC0, 0x00, 0x00, 0xFA, 0xC0, 0x80, 0x00, 0x00,
+                    0xFA, 0x47, 0xC3, 0x50, 0x00, 0xF4, 0xA0, 0xB8, 0x18);
+
+        // 24 byte 문자열은 길이가 1 byte 더 붙음
+        fb_buf_reset(&b);
+        e->str(&b, "abcdefghijklmnopqrstuvw");
+        CHECK_EQ(b.len, 1 + 23u);
+        CHECK_EQ(mem[0], 0x77);
+        fb_buf_reset(&b);
+        e->str(&b, "abcdefghijklmnopqrstuvwx");
+        CHECK_EQ(b.len, 2 + 24u);
+        CHECK_EQ(mem[0], 0x78);
+        CHECK_EQ(mem[1], 24);
+    }
+
+    // 넘침: 앞부분까지만 쓰고 overflow. JSON 은 NUL 자리도 모자라면 overflow
+    {
+        uint8_t small[16];
+        memset(small, 0xAA, sizeof(small));
+        fb_buf_t s;
+        fb_buf_init(&s, small, 10);
+        encode_batch(&fb_json_encoder, &s);
+        CHECK(s.overflow);
+        CHECK(s.len <= 10);
+        CHECK_EQ(small[10], 0xAA);
+
+        fb_buf_init(&s, small, 2);
+        fb_json_encoder.map_begin(&s, 0);
+        fb_json_encoder.map_end(&s);
+        CHECK(!s.overflow);
+        fb_json_encoder.finish(&s);
+        CHECK(s.overflow);
+
+        fb_buf_init(&s, small, 5);
+        fb_cbor_encoder.f32(&s, 1.0f, 0);
+        CHECK(!s.overflow);
+        fb_cbor_encoder.u32(&s, 1);
+        CHECK(s.overflow);
+    }
+
+    // 센서 batch 하나 인코딩 비용
+    double json_ns = host_bench_ns(1000000, [&](long) { encode_batch(&fb_json_encoder, &b); });
+    size_t json_len = b.len;
+    double cbor_ns = host_bench_ns(1000000, [&](long) { encode_batch(&fb_cbor_encoder, &b); });
+    printf("batch encode: json %.1f ns (%u bytes), cbor %.1f ns (%u bytes)\n",
+           json_ns, (unsigned)json_len, cbor_ns, (unsigned)b.len);
+
+    return host_check_result("test_fb_encoder");
+}
@@ -0,0 +1,40 @@
+// fb_key_table: 행마다 이름이 있고 겹치지 않음, fb_key_find 왕복, 타입/lane/소수 자리수 조합
+#include "host_check.h"
+#include "fb_keys.h"
+#include <string.h>
+
+int main()
+{
+    CHECK_EQ(sizeof(fb_key_table) / sizeof(fb_key_table[0]), (size_t)FB_KEY_COUNT);
+
+    for (int i = 0; i < FB_KEY_COUNT; i++) {
+        const fb_key_info_t &k = fb_key_info((fb_key_t)i);
+        CHECK(k.name && k.name[0]);
+        CHECK_EQ(fb_key_find(k.name), (fb_key_t)i);
+        for (int j = i + 1; j < FB_KEY_COUNT; j++) CHECK(strcmp(k.name, fb_key_table[j].name) != 0);
+
+        CHECK(k.lane < FB_LANE_COUNT);
+        CHECK(k.decimals <= 6);                 // fb_encoder 가 지원하는 자리수
+        CHECK(k.abs_deadband >= 0 && k.rel_deadband >= 0);
+        // on/off 값은 control lane, 모든 변화를 보냄
+        if (k.type == FB_TYPE_BOOL) {
+            CHECK_EQ(k.lane, FB_LANE_CONTROL);
+            CHECK_EQ(k.decimals, 0);
+            CHECK_NEAR(k.abs_deadband, 0, 0);
+        }
+    }
+
+    // flash 로그에 저장되는 번호라 기존 key 순서는 바뀌면 안 됨
+    CHECK_EQ(FB_KEY_TEMPERATURE, 0);
+    CHECK_STR(fb_key_table[FB_KEY_TEMPERATURE].name, "temperature");
+    CHECK_STR(fb_key_table[FB_KEY_LIGHT_INTENSITY].name, "lightIntensity");
+    CHECK_STR(fb_key_table[FB_KEY_PUMP_STATUS].name, "pumpStatus");
+
+    // 없는 이름 / 대소문자 / 앞부분만 같은 이름
+    CHECK_EQ(fb_key_find("nope"), FB_KEY_COUNT);
+    CHECK_EQ(fb_key_find(""), FB_KEY_COUNT);
+    CHECK_EQ(fb_key_find("Temperature"), FB_KEY_COUNT);
+    CHECK_EQ(fb_key_find("heatLed"), FB_KEY_COUNT);
+
+    return host_check_result("test_fb_keys");
+}
@@ -0,0 +1,76 @@
+// 오프라인 로그 재전송: 이전 부팅의 최악 길이 record (가장 긴 key 이름, 자리수가 가장 많은 값 / boot /
+// uptime / seq) 로 batch 하나를 꽉 채워도 body 에 다 들어가서 한 요청으로 나가고 ack 되는지 확인.
+// body 가 모자라면 ack 없이 돌아가서 로그가 영영 막히던 경우
+#include "host_check.h"
+#include "host_shims.h"
+#include "firebase.h"
+#include "fb_offline.h"
+#include "sdkconfig.h"
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+
+#define HOST "smart-plant-app-1-default-rtdb.asia-southeast1.firebasedatabase.app"
+#define PART_PATH "/tmp/test_fb_replay.bin"
+
+// 이 기다림 동안 plant_history 요청 수
+static int history_requests(int *last_len)
+{
+    int n = 0;
+    for (int i = 0; i < host_http_request_count(); i++) {
+        host_http_req_t req;
+        if (!host_http_get_request(i, &req) || !strstr(req.url, "/plant_history")) continue;
+        n++;
+        *last_len = req.body_len;
+    }
+    return n;
+}
+
+int main()
+{
+    remove(PART_PATH);
+    CHECK(host_partition_register(CONFIG_FB_OFFLINE_PARTITION, PART_PATH, 4 * 4096, 4096) != NULL);
+    host_dns_set(HOST, "10.0.0.7");
+    fb_queue_init();
+
+    flash_log_t *log = fb_offline_log();
+    CHECK(log != NULL);
+    if (!log) return host_check_result("test_fb_replay");
+
+    // batch 하나 + 1개. seq 는 로그가 매기므로 뒤쪽 record 일수록 이름이 길어지게 seq 를 미리 올려둠
+    log->next_seq = 4000000000u;
+    const int total = CONFIG_FB_REPLAY_BATCH + 1;
+    for (int i = 0; i < total; i++) {
+        CHECK_EQ(flash_log_append(log, FB_KEY_STACK_FREE_UPLOADER, -9.9e16f, 4294967295u, 65535, 0), 0);
+    }
+    CHECK_EQ(log->count, (uint32_t)total);
+
+    // control 값 하나로 온라인이 되면 한가한 틈에 재전송
+    firebase_uploader_start();
+    fb_update(FB_KEY_LED_STATUS, 1);
+    CHECK(host_http_wait_requests(2, 3000));
+    for (int i = 0; i < 3000 && log->count > 1; i++) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    // 첫 batch 는 통째로: 옛 고정 크기 (batch * 100 byte) 를 넘는 body
+    int len = 0;
+    CHECK_EQ(history_requests(&len), 1);
+    CHECK_EQ(log->count, 1u);
+    CHECK(len > CONFIG_FB_REPLAY_BATCH * 100);
+    host_http_req_t req;
+    CHECK(host_http_get_request(host_http_request_count() - 1, &req));
+    CHECK(strncmp(req.body, "{\"b65535_4294967295_40000000", 27) == 0);
+    CHECK(strstr(req.body, "\"k\":\"stackFreeUploader\",\"v\":-9") != NULL);
+
+    // 남은 하나는 FB_REPLAY_INTERVAL_MS 뒤 다음 batch 로
+    for (int i = 0; i < CONFIG_FB_REPLAY_INTERVAL_MS + 3000 && log->count > 0; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    CHECK_EQ(log->count, 0u);
+    CHECK_EQ(history_requests(&len), 2);
+
+    fb_metrics_t m;
+    fb_get_metrics(&m);
+    CHECK_EQ(m.http_failures, 0u);
+
+    return host_check_result("test_fb_replay");
+}
@@ -0,0 +1,245 @@
+// flash_log: 메모리 위 가짜 NOR flash (write는 bit 1->0만, 중간에 끊기는 write 주입)로
+// 섹터 경계를 넘는 ack, 한 바퀴 wrap, 쓰다 만 record, 재부팅 (다시 open) 복구, 옛 layout 무시를 확인
+#include "host_check.h"
+#include "flash_log.h"
+#include <string.h>
+#include <vector>
+
+#define SECTOR  4096
+#define SECTORS 4
+#define PER_SECTOR (SECTOR / sizeof(flash_log_rec_t))   // 204, 섹터 끝 16 byte 는 빈 자리
+
+struct mem_flash {
+    std::vector<uint8_t> data = std::vector<uint8_t>(SECTOR * SECTORS, 0xFF);
+    int32_t fail_after = -1;   // 다음 write를 이만큼만 쓰고 실패
+    uint32_t erases = 0;
+};
+
+static int mem_read(void *ctx, uint32_t off, void *buf, uint32_t len)
+{
+    mem_flash *f = (mem_flash *)ctx;
+    if (off + len > f->data.size()) return -1;
+    memcpy(buf, &f->data[off], len);
+    return 0;
+}
+
+static int mem_write(void *ctx, uint32_t off, const void *buf, uint32_t len)
+{
+    mem_flash *f = (mem_flash *)ctx;
+    if (off + len > f->data.size()) return -1;
+    // record 가 섹터를 넘으면 안 됨
+    CHECK_EQ(off / SECTOR, (off + len - 1) / SECTOR);
+    uint32_t n = len;
+    if (f->fail_after >= 0 && (uint32_t)f->fail_after < len) n = (uint32_t)f->fail_after;
+    const uint8_t *p = (const uint8_t *)buf;
+    for (uint32_t i = 0; i < n; i++) f->data[off + i] &= p[i];
+    if (n < len) {
+        f->fail_after = -1;
+        return -1;
+    }
+    return 0;
+}
+
+static int mem_erase(void *ctx, uint32_t off, uint32_t len)
+{
+    mem_flash *f = (mem_flash *)ctx;
+    CHECK_EQ(off % SECTOR, 0u);
+    memset(&f->data[off], 0xFF, len);
+    f->erases++;
+    return 0;
+}
+
+static flash_log_io_t mem_io(mem_flash *f)
+{
+    return { f, SECTOR * SECTORS, SECTOR, mem_read, mem_write, mem_erase };
+}
+
+static void append_n(flash_log_t *log, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t seq = log->next_seq;
+        CHECK_EQ(flash_log_append(log, (uint8_t)(seq % 11), (float)seq, 1000 + seq, 7, FLASH_LOG_F_WALL), 0);
+    }
+}
+
+// 다시 open 한 로그가 메모리 상태와 같은지
+static void check_reopen(mem_flash *f, const flash_log_t *live)
+{
+    flash_log_io_t io = mem_io(f);
+    flash_log_t log;
+    CHECK_EQ(flash_log_open(&log, &io), 0);
+    CHECK_EQ(log.head, live->head);
+    CHECK_EQ(log.count, live->count);
+    CHECK_EQ(log.next_seq, live->next_seq);
+    if (live->count) CHECK_EQ(log.tail, live->tail);
+}
+
+int main()
+{
+    // 빈 파티션: 용량 = 섹터 수 x 섹터당 record, 첫 append 가 섹터를 지움
+    {
+        mem_flash f;
+        flash_log_io_t io = mem_io(&f);
+        flash_log_t log;
+        CHECK_EQ(flash_log_open(&log, &io), 0);
+        CHECK_EQ(log.capacity, SECTORS * PER_SECTOR);
+        CHECK_EQ(log.count, 0);
+
+        CHECK_EQ(flash_log_append(&log, 3, 21.5f, 1700000000, 42, FLASH_LOG_F_WALL), 0);
+        CHECK_EQ(flash_log_append(&log, 4, 55.0f, 93, 43, 0), 0);
+        CHECK_EQ(f.erases, 1);
+        flash_log_rec_t r[4];
+        CHECK_EQ(flash_log_peek(&log, r, 4), 2);
+        CHECK_EQ(r[0].seq, 0);
+        CHECK_EQ(r[0].key, 3);
+        CHECK_NEAR(r[0].value, 21.5, 0);
+        CHECK_EQ(r[0].timestamp, 1700000000u);
+        CHECK_EQ(r[0].boot, 42);
+        CHECK_EQ(r[0].flags, FLASH_LOG_F_WALL);
+        CHECK_EQ(r[1].boot, 43);
+        CHECK_EQ(r[1].flags, 0);
+        CHECK_EQ(r[1].timestamp, 93u);
+        check_reopen(&f, &log);
+    }
+
+    // 섹터 경계를 넘는 ack: 300개 중 250개 전송 -> tail 이 두 번째 섹터 안, 다시 열어도 같음
+    {
+        mem_flash f;
+        flash_log_io_t io = mem_io(&f);
+        flash_log_t log;
+        flash_log_open(&log, &io);
+        append_n(&log, 300);
+        CHECK_EQ(f.erases, 2);
+
+        static flash_log_rec_t r[32];
+        uint32_t expect = 0;
+        while (expect < 250) {
+            int want = 250 - expect < 32 ? (int)(250 - expect) : 32;
+            int n = flash_log_peek(&log, r, want);
+            CHECK_EQ(n, want);
+            for (int i = 0; i < n; i++) CHECK_EQ(r[i].seq, expect + i);
+            CHECK_EQ(flash_log_ack(&log, n), 0);
+            expect += n;
+        }
+        CHECK_EQ(log.count, 50);
+        CHECK_EQ(log.tail, 250);
+        check_reopen(&f, &log);
+
+        // 남은 것은 250부터
+        CHECK_EQ(flash_log_peek(&log, r, 1), 1);
+        CHECK_EQ(r[0].seq, 250);
+        // 보낸 record 는 state 만 0 으로 (erase 없음)
+        CHECK_EQ(f.erases, 2);
+    }
+
+    // wrap: 보내지 못한 채 용량 + 300 개 -> 섹터 단위로 오래된 것부터 버림
+    {
+        mem_flash f;
+        flash_log_io_t io = mem_io(&f);
+        flash_log_t log;
+        flash_log_open(&log, &io);
+        const uint32_t cap = log.capacity;
+        append_n(&log, cap + 300);
+
+        // head 는 두 번째 섹터 안 (300): 첫 두 섹터가 다시 지워짐
+        CHECK_EQ(log.head, 300);
+        CHECK_EQ(log.dropped, 2 * PER_SECTOR);
+        CHECK_EQ(log.count, cap + 300 - 2 * PER_SECTOR);
+        CHECK_EQ(log.tail, 2 * PER_SECTOR);
+        CHECK_EQ(f.erases, SECTORS + 2);
+
+        flash_log_rec_t r;
+        CHECK_EQ(flash_log_peek(&log, &r, 1), 1);
+        CHECK_EQ(r.seq, 2 * PER_SECTOR);
+        check_reopen(&f, &log);
+
+        // 한 바퀴 넘게 돌아도 다시 열면 가장 큰 seq 다음부터
+        flash_log_t again;
+        flash_log_open(&again, &io);
+        append_n(&again, 1);
+        CHECK_EQ(flash_log_peek(&again, &r, 1), 1);
+        CHECK_EQ(r.seq, 2 * PER_SECTOR);
+        CHECK_EQ(again.next_seq, cap + 301);
+    }
+
+    // 쓰다 만 record (write 도중 전원 차단): append 실패, 다시 열면 무시하고 그 다음 칸부터
+    {
+        mem_flash f;
+        flash_log_io_t io = mem_io(&f);
+        flash_log_t log;
+        flash_log_open(&log, &io);
+        append_n(&log, 10);
+        f.fail_after = 7;
+        CHECK_EQ(flash_log_append(&log, 1, 1.0f, 1, 7, 0), -1);
+        CHECK_EQ(log.errors, 1);
+        CHECK_EQ(log.count, 10);
+
+        flash_log_t reboot;
+        CHECK_EQ(flash_log_open(&reboot, &io), 0);
+        CHECK_EQ(reboot.count, 10);
+        CHECK_EQ(reboot.head, 10);          // 깨진 칸은 아직 head
+        append_n(&reboot, 5);               // 깨진 칸을 건너뜀
+        CHECK_EQ(reboot.head, 16);
+        CHECK_EQ(reboot.count, 16);         // 깨진 칸도 tail..head 안
+
+        static flash_log_rec_t r[32];
+        CHECK_EQ(flash_log_peek(&reboot, r, 32), 15);
+        for (int i = 0; i < 15; i++) CHECK_EQ(r[i].seq, (uint32_t)i);
+        check_reopen(&f, &reboot);
+
+        // 섹터 마지막 칸에서 끊겨도 다음 섹터로 넘어감
+        append_n(&reboot, PER_SECTOR - 1 - reboot.head);
+        CHECK_EQ(reboot.head, PER_SECTOR - 1);
+        f.fail_after = 3;
+        CHECK_EQ(flash_log_append(&reboot, 1, 1.0f, 1, 7, 0), -1);
+        flash_log_t again;
+        flash_log_open(&again, &io);
+        append_n(&again, 1);
+        CHECK_EQ(again.head, PER_SECTOR + 1);
+        CHECK_EQ(again.count, PER_SECTOR + 1);
+        static flash_log_rec_t all[PER_SECTOR + 1];
+        CHECK_EQ(flash_log_peek(&again, all, PER_SECTOR + 1), PER_SECTOR - 1);   // 깨진 칸 둘 빼고
+        CHECK_EQ(flash_log_ack(&again, PER_SECTOR - 1), 0);
+        CHECK_EQ(again.count, 0);
+    }
+
+    // ack 도중 끊겨도 (state byte 하나라 원자적) 다시 열면 보낸 것까지만 빠짐
+    {
+        mem_flash f;
+        flash_log_io_t io = mem_io(&f);
+        flash_log_t log;
+        flash_log_open(&log, &io);
+        append_n(&log, 20);
+        flash_log_rec_t r[8];
+        flash_log_peek(&log, r, 8);
+        f.fail_after = 0;    // 첫 state write 실패
+        CHECK_EQ(flash_log_ack(&log, 8), -1);
+        flash_log_t reboot;
+        flash_log_open(&reboot, &io);
+        CHECK_EQ(reboot.count, 20);
+        CHECK_EQ(reboot.tail, 0);
+    }
+
+    // layout 이 다른 옛 로그 (16 byte record) 는 record 로 보지 않음
+    {
+        mem_flash f;
+        for (uint32_t i = 0; i < 200; i++) {
+            uint8_t old[16];
+            memset(old, 0, sizeof(old));
+            memcpy(old, &i, 4);
+            old[13] = 0xFE;
+            memcpy(&f.data[i * 16], old, 16);
+        }
+        flash_log_io_t io = mem_io(&f);
+        flash_log_t log;
+        CHECK_EQ(flash_log_open(&log, &io), 0);
+        CHECK_EQ(log.count, 0);
+        CHECK_EQ(log.next_seq, 0);
+        append_n(&log, 3);
+        flash_log_rec_t r[4];
+        CHECK_EQ(flash_log_peek(&log, r, 4), 3);
+        CHECK_EQ(r[0].seq, 0);
+    }
+
+    return host_check_result("test_flash_log");
+}
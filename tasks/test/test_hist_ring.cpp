@@ -0,0 +1,88 @@
+// hist_ring: raw ring wrap, 분/시간 bucket 경계 (start 0 인 첫 bucket 포함), 시간 공백, rollup ring wrap,
+// min/max/avg. 샘플 하나 추가 비용도 출력
+#include "host_check.h"
+#include "hist_ring.h"
+
+int main()
+{
+    static hist_ring_t h;
+
+    // 빈 ring
+    hist_ring_init(&h);
+    CHECK(hist_ring_sample(&h, 0) == NULL);
+    CHECK(hist_ring_rollup(&h, HIST_LEVEL_MINUTE, 0) == NULL);
+    CHECK_EQ(hist_ring_rollup_count(&h, HIST_LEVEL_HOUR), 0);
+    CHECK_NEAR(hist_rollup_avg(&h.open[HIST_LEVEL_MINUTE]), 0, 0);
+
+    // raw: 최근 HIST_RAW_LEN 개만, 0 = 최신
+    for (uint32_t i = 0; i < 100; i++) hist_ring_add(&h, (float)i, i);
+    CHECK_EQ(h.raw_count, HIST_RAW_LEN);
+    CHECK_EQ(h.samples, 100);
+    CHECK_NEAR(hist_ring_sample(&h, 0)->value, 99, 0);
+    CHECK_EQ(hist_ring_sample(&h, HIST_RAW_LEN - 1)->t, 100u - HIST_RAW_LEN);
+    CHECK(hist_ring_sample(&h, HIST_RAW_LEN) == NULL);
+    CHECK(hist_ring_sample(&h, -1) == NULL);
+
+    // 분 bucket: 10 s 마다, t=0 부터 3분 + 1 샘플 -> 닫힌 bucket 0/60/120 (각 6개), 180 은 열려 있음
+    hist_ring_init(&h);
+    for (uint32_t t = 0; t <= 180; t += 10) hist_ring_add(&h, (float)(t % 60) - 20, t);
+    CHECK_EQ(hist_ring_rollup_count(&h, HIST_LEVEL_MINUTE), 3);
+    for (int i = 0; i < 3; i++) {
+        const hist_rollup_t *r = hist_ring_rollup(&h, HIST_LEVEL_MINUTE, i);
+        CHECK_EQ(r->start, (uint32_t)(120 - 60 * i));
+        CHECK_EQ(r->count, 6);
+        CHECK_NEAR(r->min, -20, 0);
+        CHECK_NEAR(r->max, 30, 0);
+        CHECK_NEAR(hist_rollup_avg(r), 5, 1e-6);
+    }
+    CHECK_EQ(h.open[HIST_LEVEL_MINUTE].start, 180u);
+    CHECK_EQ(h.open[HIST_LEVEL_MINUTE].count, 1);
+    // 시간 bucket 은 아직 열린 것 하나 (start 0)
+    CHECK_EQ(hist_ring_rollup_count(&h, HIST_LEVEL_HOUR), 0);
+    CHECK_EQ(h.open[HIST_LEVEL_HOUR].start, 0u);
+    CHECK_EQ(h.open[HIST_LEVEL_HOUR].count, 19);
+
+    // 시간 경계: start 0 인 첫 시간도 정상적으로 닫힘 (3600 s 에서)
+    hist_ring_init(&h);
+    for (uint32_t t = 0; t < 3600; t += 10) hist_ring_add(&h, 1.0f, t);
+    CHECK_EQ(hist_ring_rollup_count(&h, HIST_LEVEL_HOUR), 0);
+    hist_ring_add(&h, 5.0f, 3600);
+    CHECK_EQ(hist_ring_rollup_count(&h, HIST_LEVEL_HOUR), 1);
+    CHECK_EQ(hist_ring_rollup(&h, HIST_LEVEL_HOUR, 0)->start, 0u);
+    CHECK_EQ(hist_ring_rollup(&h, HIST_LEVEL_HOUR, 0)->count, 360);
+    CHECK_EQ(h.open[HIST_LEVEL_HOUR].start, 3600u);
+    // 한 시간 = 분 bucket 60개라 minute ring 이 딱 참
+    CHECK_EQ(hist_ring_rollup_count(&h, HIST_LEVEL_MINUTE), HIST_MINUTE_LEN);
+    CHECK_EQ(hist_ring_rollup(&h, HIST_LEVEL_MINUTE, HIST_MINUTE_LEN - 1)->start, 0u);
+
+    // 공백 (샘플 없는 분): 빈 bucket 을 만들지 않고 다음 bucket 으로
+    hist_ring_init(&h);
+    hist_ring_add(&h, 1.0f, 1700000000);
+    hist_ring_add(&h, 2.0f, 1700000000 + 600);
+    CHECK_EQ(hist_ring_rollup_count(&h, HIST_LEVEL_MINUTE), 1);
+    CHECK_EQ(hist_ring_rollup(&h, HIST_LEVEL_MINUTE, 0)->start, 1700000000u - 1700000000u % 60);
+    CHECK_EQ(h.open[HIST_LEVEL_MINUTE].start, (1700000000u + 600) / 60 * 60);
+
+    // hour ring wrap: 10분마다 30시간 -> 닫힌 29시간 중 최근 24개 (5..28시)
+    hist_ring_init(&h);
+    const uint32_t base = 1700000000u / 3600 * 3600;
+    for (uint32_t t = 0; t < 30 * 3600; t += 600) hist_ring_add(&h, (float)(t / 3600), base + t);
+    CHECK_EQ(hist_ring_rollup_count(&h, HIST_LEVEL_HOUR), HIST_HOUR_LEN);
+    CHECK_EQ(hist_ring_rollup(&h, HIST_LEVEL_HOUR, 0)->start, base + 28 * 3600);
+    CHECK_EQ(hist_ring_rollup(&h, HIST_LEVEL_HOUR, HIST_HOUR_LEN - 1)->start, base + 5 * 3600);
+    CHECK(hist_ring_rollup(&h, HIST_LEVEL_HOUR, HIST_HOUR_LEN) == NULL);
+    for (int i = 0; i < HIST_HOUR_LEN; i++) {
+        const hist_rollup_t *r = hist_ring_rollup(&h, HIST_LEVEL_HOUR, i);
+        CHECK_EQ(r->count, 6);
+        CHECK_NEAR(hist_rollup_avg(r), (float)(28 - i), 0);
+    }
+    CHECK_EQ(h.open[HIST_LEVEL_HOUR].start, base + 29 * 3600);
+    CHECK_EQ(hist_ring_rollup_count(&h, HIST_LEVEL_MINUTE), HIST_MINUTE_LEN);
+
+    // 샘플 하나 추가 비용 (10 s 간격)
+    hist_ring_init(&h);
+    double ns = host_bench_ns(1000000, [&](long i) { hist_ring_add(&h, (float)(i & 63), (uint32_t)i * 10); });
+    printf("hist_ring_add %.1f ns, sizeof(hist_ring_t) %u\n", ns, (unsigned)sizeof(hist_ring_t));
+
+    return host_check_result("test_hist_ring");
+}
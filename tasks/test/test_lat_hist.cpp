@@ -0,0 +1,60 @@
+// lat_hist: bucket 경계 (2^k - 1 / 2^k), 0 us, 마지막 bucket 포화, 상한, 백분위
+#include "host_check.h"
+#include "lat_hist.h"
+
+int main()
+{
+    // bucket 0 = 0 us, bucket i = [2^(i-1), 2^i)
+    CHECK_EQ(lat_hist_bucket(0), 0);
+    CHECK_EQ(lat_hist_bucket(1), 1);
+    for (int k = 1; k < LAT_HIST_BUCKETS - 1; k++) {
+        CHECK_EQ(lat_hist_bucket((1u << k) - 1), k);
+        CHECK_EQ(lat_hist_bucket(1u << k), k + 1);
+    }
+    // 2^22 us 이상은 전부 마지막 bucket
+    CHECK_EQ(lat_hist_bucket((1u << 22) - 1), LAT_HIST_BUCKETS - 2);
+    CHECK_EQ(lat_hist_bucket(1u << 22), LAT_HIST_BUCKETS - 1);
+    CHECK_EQ(lat_hist_bucket(UINT32_MAX), LAT_HIST_BUCKETS - 1);
+
+    // 상한: bucket b 에 들어가는 가장 큰 값, 마지막 bucket 은 max_us
+    lat_hist_t h = {};
+    for (int b = 0; b < LAT_HIST_BUCKETS - 1; b++) {
+        uint32_t upper = lat_hist_bucket_upper(&h, b);
+        CHECK_EQ(lat_hist_bucket(upper), b);
+        CHECK(b == LAT_HIST_BUCKETS - 2 || lat_hist_bucket(upper + 1) == b + 1);
+    }
+    lat_hist_add(&h, 10000000);
+    CHECK_EQ(lat_hist_bucket_upper(&h, LAT_HIST_BUCKETS - 1), 10000000u);
+
+    // 백분위: 빈 histogram 은 0, 값 하나면 그 값을 넘지 않음
+    h = {};
+    CHECK_EQ(lat_hist_percentile(&h, 50), 0u);
+    lat_hist_add(&h, 5);
+    CHECK_EQ(lat_hist_percentile(&h, 0), 5u);     // bucket 상한 7 이지만 max 5 로 자름
+    CHECK_EQ(lat_hist_percentile(&h, 100), 5u);
+
+    // 1..1000 us 하나씩: p50 은 500 이 든 bucket [256, 512) 의 상한, 그 위는 [512, 1024) 이지만 max 1000 으로 자름
+    h = {};
+    for (uint32_t us = 1; us <= 1000; us++) lat_hist_add(&h, us);
+    CHECK_EQ(h.count, 1000);
+    CHECK_EQ(h.sum_us, 500500u);
+    CHECK_EQ(h.max_us, 1000u);
+    CHECK_EQ(lat_hist_percentile(&h, 50), 511u);
+    CHECK_EQ(lat_hist_percentile(&h, 51), 511u);
+    CHECK_EQ(lat_hist_percentile(&h, 52), 1000u);
+    CHECK_EQ(lat_hist_percentile(&h, 25), 255u);
+    CHECK_EQ(lat_hist_percentile(&h, 99), 1000u);
+    // 1..511 이 51.1% 라서 p51 까지는 511
+    CHECK_EQ(h.buckets[lat_hist_bucket(511)], 256u);
+    CHECK_EQ(h.buckets[lat_hist_bucket(512)], 489u);
+
+    // 0 us 샘플 (같은 tick 안에서 끝남) 은 bucket 0, 상한 0
+    h = {};
+    for (int i = 0; i < 9; i++) lat_hist_add(&h, 0);
+    lat_hist_add(&h, 3000);
+    CHECK_EQ(h.buckets[0], 9u);
+    CHECK_EQ(lat_hist_percentile(&h, 90), 0u);
+    CHECK_EQ(lat_hist_percentile(&h, 91), 3000u);
+
+    return host_check_result("test_lat_hist");
+}
@@ -0,0 +1,115 @@
+// report_policy: 하루치 합성 trace (10 s 샘플)를 app_main과 같은 정책 (fb_key_table deadband, 최대 10분)으로
+// 재생해서 보낸 수를 세고, step / 최소 간격 / 상대 deadband 동작을 확인
+#include "host_check.h"
+#include "report_policy.h"
+#include "fb_keys.h"
+#include <random>
+
+#define SAMPLE_MS   10000u
+#define DAY_MS      (24u * 3600u * 1000u)
+#define SAMPLES     (DAY_MS / SAMPLE_MS)
+#define HEARTBEAT_MS (10u * 60u * 1000u)
+
+static report_policy_t key_policy(fb_key_t key)
+{
+    return { fb_key_info(key).abs_deadband, fb_key_info(key).rel_deadband, 0, HEARTBEAT_MS };
+}
+
+// trace(t_ms) 값을 SAMPLES 개 재생, 보낸 수 반환
+template <typename F>
+static uint32_t replay(const report_policy_t &policy, report_state_t *st, F trace)
+{
+    uint32_t sent = 0;
+    for (uint32_t i = 0; i < SAMPLES; i++) {
+        uint64_t t = (uint64_t)i * SAMPLE_MS;
+        if (report_policy_check(&policy, st, trace(t), t)) sent++;
+    }
+    return sent;
+}
+
+int main()
+{
+    std::mt19937 rng(7);
+    std::normal_distribution<float> noise(0.0f, 0.05f);
+
+    // 온도: 하루 주기 ±3 C + 잡음 0.05 C, deadband 0.5 C
+    report_state_t temp = {};
+    uint32_t temp_sent = replay(key_policy(FB_KEY_TEMPERATURE), &temp, [&](uint64_t t) {
+        return 22.0f + 3.0f * sinf(2 * (float)M_PI * t / DAY_MS) + noise(rng);
+    });
+    // 잡음이 deadband보다 훨씬 작으면 정지 상태: 10분 heartbeat만
+    report_state_t flat = {};
+    uint32_t flat_sent = replay(key_policy(FB_KEY_HUMIDITY), &flat, [&](uint64_t) { return 55.0f + noise(rng); });
+    // 조도: 낮에만 빛 (샘플마다 ±3% 흔들림), 밤 0 lux. 10% 상대 deadband (0 근처에서는 1 lux)
+    std::uniform_real_distribution<float> cloud(0.97f, 1.03f);
+    report_state_t light = {};
+    uint32_t light_sent = replay(key_policy(FB_KEY_LIGHT_INTENSITY), &light, [&](uint64_t t) {
+        float day = sinf(2 * (float)M_PI * t / DAY_MS);
+        return day > 0 ? 800.0f * day * cloud(rng) : 0.0f;
+    });
+    // 토양 수분: 하루에 60 -> 40 % 로 천천히 마름, 오후에 물 줌 (step)
+    report_state_t soil = {};
+    uint64_t water_at = 15ull * 3600 * 1000;
+    uint32_t soil_sent = replay(key_policy(FB_KEY_SOIL_MOISTURE), &soil, [&](uint64_t t) {
+        return t < water_at ? 60.0f - 20.0f * t / DAY_MS : 70.0f;
+    });
+
+    printf("%u samples/key -> sent temperature=%u humidity=%u light=%u soil=%u\n",
+           (unsigned)SAMPLES, temp_sent, flat_sent, light_sent, soil_sent);
+
+    for (const report_state_t *st : { &temp, &flat, &light, &soil }) {
+        CHECK_EQ(st->emitted + st->suppressed, SAMPLES);
+    }
+    CHECK_EQ(flat_sent, DAY_MS / HEARTBEAT_MS);      // 첫 값 + 10분마다
+    // 온도: ±3 C 하루 주기는 10분에 많아야 0.13 C 라서 deadband(0.5)보다 heartbeat가 먼저 옴
+    CHECK(temp_sent >= DAY_MS / HEARTBEAT_MS && temp_sent < DAY_MS / HEARTBEAT_MS + 10);
+    // 조도: 해 뜨고 질 때 빠르게 바뀌는 구간만 10% 마다, 나머지는 heartbeat
+    CHECK(light_sent < SAMPLES / 20);
+    // 토양: 0.2 %/시간 변화 -> 5시간마다 1 % 라서 거의 heartbeat, 물 준 순간은 바로 보냄
+    CHECK(soil_sent <= DAY_MS / HEARTBEAT_MS + 6);
+    CHECK_NEAR(soil.last_value, 70.0f, 0);
+
+    // step은 다음 샘플에서 바로 (최소 간격 0)
+    {
+        report_policy_t p = key_policy(FB_KEY_SOIL_MOISTURE);
+        report_state_t st = {};
+        CHECK(report_policy_check(&p, &st, 50.0f, 0));
+        CHECK(!report_policy_check(&p, &st, 50.9f, 10000));
+        CHECK(report_policy_check(&p, &st, 51.0f, 20000));   // abs deadband 1.0 이상
+        CHECK(!report_policy_check(&p, &st, 50.5f, 30000));
+        CHECK(report_policy_check(&p, &st, 50.5f, 20000 + HEARTBEAT_MS));  // 변화 없어도 heartbeat
+    }
+
+    // 최소 간격: 매 샘플 크게 바뀌어도 60 s에 한 번만
+    {
+        report_policy_t p = { 0.5f, 0, 60000, 0 };
+        report_state_t st = {};
+        uint32_t sent = replay(p, &st, [](uint64_t t) { return (float)(t / 1000); });
+        CHECK_EQ(sent, DAY_MS / 60000);
+    }
+
+    // 상대 deadband: 100 -> 109 는 보류, 110 은 보냄 (abs 1 lux보다 넓음). 0 근처에서는 abs deadband가 하한
+    {
+        report_policy_t p = key_policy(FB_KEY_LIGHT_INTENSITY);
+        report_state_t st = {};
+        CHECK(report_policy_check(&p, &st, 100.0f, 0));
+        CHECK(!report_policy_check(&p, &st, 109.0f, 1));
+        CHECK(report_policy_check(&p, &st, 110.0f, 2));
+        CHECK(report_policy_check(&p, &st, 0.0f, 3));
+        CHECK(!report_policy_check(&p, &st, 0.5f, 4));
+        CHECK(report_policy_check(&p, &st, 1.0f, 5));
+    }
+
+    // deadband 둘 다 0 (on/off 같은 값): 조금이라도 바뀌면 보냄, 같으면 안 보냄
+    {
+        report_policy_t p = { 0, 0, 0, 0 };
+        report_state_t st = {};
+        CHECK(report_policy_check(&p, &st, 1, 0));
+        CHECK(!report_policy_check(&p, &st, 1, 100000000));
+        CHECK(report_policy_check(&p, &st, 0, 100000001));
+        CHECK_EQ(st.emitted, 2);
+        CHECK_EQ(st.suppressed, 1);
+    }
+
+    return host_check_result("test_report_policy");
+}
@@ -0,0 +1,120 @@
+// 시간 rollup 업로드: 측정값마다 같은 시간이 다른 시각에 닫혀도 (늦게 닫힌 것도) 빠짐없이, 업로드가
+// 실패한 옛 시간은 더 새 시간보다 먼저 다시, 측정값별로 2xx 를 받은 뒤에만 진행하는지 확인.
+// 벽시계는 host_time_set() 으로, 재시도 대기는 가상 esp_timer 로
+#include "host_check.h"
+#include "host_shims.h"
+#include "firebase.h"
+#include "history.h"
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define HOST "smart-plant-app-1-default-rtdb.asia-southeast1.firebasedatabase.app"
+#define T0   1750003200u   // 정시 (3600 의 배수)
+#define HOUR 3600u
+
+static int s_requests;
+
+// control 값 하나로 uploader 를 깨우면 control PATCH 뒤 한가한 틈에 rollup 을 (남은 만큼) 보냄.
+// 그동안 새로 나간 plant_rollup body 들
+static std::vector<std::string> kick()
+{
+    static float led;
+    led = led ? 0.0f : 1.0f;
+    fb_update(FB_KEY_LED_STATUS, led);
+    host_http_wait_requests(s_requests + 1, 3000);
+    // rollup 이 더 없을 때까지 (요청 수가 멈출 때까지) 기다림
+    for (int idle = 0; idle < 200; idle++) {
+        int n = host_http_request_count();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        if (host_http_request_count() != n) idle = 0;
+    }
+
+    std::vector<std::string> out;
+    for (; s_requests < host_http_request_count(); s_requests++) {
+        host_http_req_t req;
+        if (host_http_get_request(s_requests, &req) && strstr(req.url, "/plant_rollup")) out.push_back(req.body);
+    }
+    return out;
+}
+
+static void record_at(uint32_t t, history_id_t id, float value)
+{
+    host_time_set(t);
+    history_record(id, value);
+}
+
+static std::string key(uint32_t start, const char *name)
+{
+    char buf[48];
+    snprintf(buf, sizeof(buf), "\"%lu/%s\":", (unsigned long)start, name);
+    return buf;
+}
+
+static bool has(const std::string &body, uint32_t start, const char *name)
+{
+    return body.find(key(start, name)) != std::string::npos;
+}
+
+int main()
+{
+    host_timer_set_virtual(1000000);
+    host_dns_set(HOST, "10.0.0.7");
+    history_init();
+    fb_queue_init();
+    firebase_uploader_start();
+
+    // 시간 T0 에 네 측정값 모두
+    for (int i = 0; i < HISTORY_COUNT; i++) record_at(T0 + 10, (history_id_t)i, 20.0f + i);
+    CHECK(kick().empty());  // 아직 닫힌 시간 없음
+
+    // 온도 / 습도만 T0 를 닫음 -> 둘만 든 block 하나
+    record_at(T0 + HOUR + 5, HISTORY_TEMPERATURE, 21.0f);
+    record_at(T0 + HOUR + 5, HISTORY_HUMIDITY, 41.0f);
+    std::vector<std::string> sent = kick();
+    CHECK_EQ(sent.size(), 1u);
+    if (sent.size() == 1) {
+        CHECK(has(sent[0], T0, "temperature"));
+        CHECK(has(sent[0], T0, "humidity"));
+        CHECK(!has(sent[0], T0, "soilMoisture"));
+        CHECK(!has(sent[0], T0, "lightIntensity"));
+        CHECK(sent[0].find("\"temperature\":{\"n\":1,") == std::string::npos);  // 이름은 경로 key 안에만
+    }
+
+    // 흙 / 빛은 같은 시간을 조금 늦게 닫음. 이 업로드는 서버가 거절 (control PATCH 는 성공)
+    record_at(T0 + HOUR + 30, HISTORY_SOIL_MOISTURE, 30.0f);
+    record_at(T0 + HOUR + 30, HISTORY_LIGHT, 500.0f);
+    host_http_push_result(ESP_OK, 200);
+    host_http_push_result(ESP_OK, 503);
+    sent = kick();
+    CHECK_EQ(sent.size(), 1u);
+    if (sent.size() == 1) {
+        CHECK(has(sent[0], T0, "soilMoisture"));
+        CHECK(has(sent[0], T0, "lightIntensity"));
+        CHECK(!has(sent[0], T0, "temperature"));
+    }
+
+    // 그 사이 온도가 T0+1h 도 닫음. 재시도 대기 (FB_RETRY_MS) 안에는 rollup 을 보내지 않음
+    record_at(T0 + 2 * HOUR + 5, HISTORY_TEMPERATURE, 22.0f);
+    CHECK(kick().empty());
+
+    // 대기가 지나면 실패한 옛 시간 (흙 / 빛 T0) 이 먼저, 그다음 온도 T0+1h. 이미 올린 온도 / 습도 T0 는 다시 안 보냄
+    host_timer_advance_us(3000000);
+    sent = kick();
+    CHECK_EQ(sent.size(), 2u);
+    if (sent.size() == 2) {
+        CHECK(has(sent[0], T0, "soilMoisture"));
+        CHECK(has(sent[0], T0, "lightIntensity"));
+        CHECK(!has(sent[0], T0, "temperature"));
+        CHECK(has(sent[1], T0 + HOUR, "temperature"));
+        CHECK(!has(sent[1], T0, "temperature"));
+        CHECK(!has(sent[1], T0 + HOUR, "humidity"));
+    }
+
+    // 모두 올렸으면 더 보낼 것 없음
+    CHECK(kick().empty());
+
+    return host_check_result("test_rollup_upload");
+}
@@ -0,0 +1,102 @@
+// sched_heap: 가상 시계로 drift (실행 시간이 쌓여도 due가 밀리지 않음), 실행 순서, 밀린 주기 건너뛰기, 용량
+#include "host_check.h"
+#include "sched_heap.h"
+
+static int s_calls[SCHED_MAX_ENTRIES];
+
+static void count_fn(void *ctx)
+{
+    s_calls[(intptr_t)ctx]++;
+}
+
+// 스케줄러 태스크와 같은 루프: due 된 것을 모두 돌리고 (하나당 cost_ms), 다음 due까지 시계를 넘김
+static uint64_t run_until(sched_heap_t *s, uint64_t now, uint64_t end, uint32_t cost_ms)
+{
+    while (now < end) {
+        sched_entry_t *e;
+        while ((e = sched_heap_pop_due(s, now)) != NULL) {
+            e->fn(e->ctx);
+            now += cost_ms;
+        }
+        uint64_t next = sched_heap_next_due(s);
+        now = next > now ? next : now;
+    }
+    return now;
+}
+
+int main()
+{
+    // drift: 10 s 주기에 실행마다 37 ms, 1000 주기 뒤에도 due는 정확히 k * period
+    {
+        sched_heap_t s = {};
+        CHECK_EQ(sched_heap_add(&s, "soil", count_fn, (void *)0, 10000, 0), 0);
+        run_until(&s, 0, 1000ULL * 10000, 37);
+        const sched_entry_t *e = &s.entries[0];
+        CHECK_EQ(e->runs, 1000);
+        CHECK_EQ(e->due_ms, 1000ULL * 10000);
+        CHECK_EQ(e->max_late_ms, 0);
+        CHECK_EQ(e->skipped, 0);
+    }
+
+    // 여러 주기가 섞여도 due 순서대로, [0, end) 구간 실행 횟수 = end / 주기 (t=0에 바로 한 번 포함)
+    {
+        sched_heap_t s = {};
+        const uint32_t periods[] = { 20000, 10000, 10000, 60000, 300000, 300000, 300000, 300000 };
+        for (int i = 0; i < 8; i++) {
+            s_calls[i] = 0;
+            CHECK(sched_heap_add(&s, "e", count_fn, (void *)(intptr_t)i, periods[i], 0) >= 0);
+        }
+        uint64_t end = 3600ULL * 1000;  // 1시간
+        run_until(&s, 0, end, 5);
+        for (int i = 0; i < 8; i++) {
+            CHECK_EQ(s_calls[i], (int)(end / periods[i]));
+            CHECK_EQ(s.entries[i].skipped, 0);
+            // 같은 시각에 due 된 항목들 뒤에서 기다린 시간: 앞 항목 수 x 5 ms 이하
+            CHECK(s.entries[i].max_late_ms <= 7 * 5);
+        }
+        CHECK_EQ(sched_heap_next_due(&s), end);
+    }
+
+    // 한 번 크게 밀림 (긴 Wi-Fi / flash 작업): 놓친 주기는 몰아서 돌리지 않고 건너뜀, 격자는 유지
+    {
+        sched_heap_t s = {};
+        sched_heap_add(&s, "dht11", count_fn, (void *)0, 1000, 0);
+        CHECK(sched_heap_pop_due(&s, 0) != NULL);        // t=0 실행, 다음 due 1000
+        CHECK(sched_heap_pop_due(&s, 999) == NULL);
+        sched_entry_t *e = sched_heap_pop_due(&s, 4500);  // 3.5 주기 늦음
+        CHECK(e != NULL);
+        CHECK_EQ(e->last_late_ms, 3500);
+        CHECK_EQ(e->skipped, 3);                         // 2000, 3000, 4000 건너뜀
+        CHECK_EQ(e->due_ms, 5000);
+        CHECK(sched_heap_pop_due(&s, 4999) == NULL);
+        e = sched_heap_pop_due(&s, 5000);
+        CHECK_EQ(e->last_late_ms, 0);
+        CHECK_EQ(e->runs, 3);
+        CHECK_EQ(e->max_late_ms, 3500);
+    }
+
+    // 첫 due를 늦게 준 항목은 그때부터
+    {
+        sched_heap_t s = {};
+        sched_heap_add(&s, "a", count_fn, (void *)0, 100, 50);
+        sched_heap_add(&s, "b", count_fn, (void *)1, 100, 10);
+        CHECK_EQ(sched_heap_next_due(&s), 10);
+        CHECK_STR(sched_heap_pop_due(&s, 60)->name, "b");
+        CHECK_STR(sched_heap_pop_due(&s, 60)->name, "a");
+        CHECK(sched_heap_pop_due(&s, 60) == NULL);
+        CHECK_EQ(sched_heap_next_due(&s), 110);
+    }
+
+    // 용량 / 잘못된 주기
+    {
+        sched_heap_t s = {};
+        CHECK_EQ(sched_heap_next_due(&s), UINT64_MAX);
+        CHECK(sched_heap_pop_due(&s, 0) == NULL);
+        CHECK_EQ(sched_heap_add(&s, "zero", count_fn, NULL, 0, 0), -1);
+        for (int i = 0; i < SCHED_MAX_ENTRIES; i++) CHECK_EQ(sched_heap_add(&s, "e", count_fn, NULL, 1000, i), i);
+        CHECK_EQ(sched_heap_add(&s, "full", count_fn, NULL, 1000, 0), -1);
+        CHECK_EQ(s.count, SCHED_MAX_ENTRIES);
+    }
+
+    return host_check_result("test_sched_heap");
+}
@@ -0,0 +1,136 @@
+// sensor_bus: sink 들이 받은 record 를 trace 로 남겨서 전달 순서 (구독 순), 같은 record 포인터, seq,
+// key filter, sink 별 보고 정책 상태, 구독 한도, 모르는 key 를 확인
+#include "host_check.h"
+#include "sensor_bus.h"
+#include <string>
+#include <vector>
+
+struct trace_t {
+    std::string sink;
+    fb_key_t    key;
+    uint32_t    seq;
+    float       value;
+    const sensor_reading_t *rec;
+};
+
+static std::vector<trace_t> s_trace;
+
+static void sink(const sensor_reading_t *r, void *ctx)
+{
+    s_trace.push_back({ (const char *)ctx, r->key, r->seq, r->value, r });
+}
+
+static sensor_reading_t reading(fb_key_t key, float value, uint64_t t_ms)
+{
+    return { key, 3, value, t_ms, 0 };
+}
+
+// 이번 publish 에서 나온 sink 이름들 ("history,matter"). 다음 호출까지 유효
+static const char *sinks_since(size_t from)
+{
+    static std::string out;
+    out.clear();
+    for (size_t i = from; i < s_trace.size(); i++) out += (out.empty() ? "" : ",") + s_trace[i].sink;
+    return out.c_str();
+}
+
+int main()
+{
+    static sensor_bus_t bus;
+    static report_policy_t policies[FB_KEY_COUNT];
+    // 온도: 0.5 이상 바뀌거나 60 s 마다, 최소 1 s 간격
+    policies[FB_KEY_TEMPERATURE] = { 0.5f, 0, 1000, 60000 };
+    policies[FB_KEY_HUMIDITY] = { 2.0f, 0, 0, 0 };
+
+    // 앱과 같은 모양: history 는 전부, matter 는 측정값 key + 정책, firebase 는 정책만
+    const uint32_t measure = SENSOR_KEY_BIT(FB_KEY_TEMPERATURE) | SENSOR_KEY_BIT(FB_KEY_HUMIDITY);
+    sensor_sub_cfg_t history = { "history", sink, (void *)"history", 0, NULL };
+    sensor_sub_cfg_t matter = { "matter", sink, (void *)"matter", measure, policies };
+    sensor_sub_cfg_t firebase = { "firebase", sink, (void *)"firebase", 0, policies };
+    CHECK_EQ(sensor_bus_subscribe(&bus, &history), 0);
+    CHECK_EQ(sensor_bus_subscribe(&bus, &matter), 1);
+    CHECK_EQ(sensor_bus_subscribe(&bus, &firebase), 2);
+
+    // 첫 값: 모두에게 구독 순서대로, 같은 record 포인터, seq 1
+    sensor_reading_t r = reading(FB_KEY_TEMPERATURE, 21.0f, 0);
+    CHECK_EQ(sensor_bus_publish(&bus, &r), 3);
+    CHECK_STR(sinks_since(0), "history,matter,firebase");
+    for (const trace_t &t : s_trace) {
+        CHECK(t.rec == &r);
+        CHECK_EQ(t.seq, 1u);
+        CHECK_EQ(t.key, FB_KEY_TEMPERATURE);
+    }
+
+    // deadband 안 (0.2) 이고 min interval 안: history 만
+    size_t at = s_trace.size();
+    r = reading(FB_KEY_TEMPERATURE, 21.2f, 500);
+    CHECK_EQ(sensor_bus_publish(&bus, &r), 1);
+    CHECK_STR(sinks_since(at), "history");
+    CHECK_EQ(r.seq, 2u);
+
+    // deadband 밖이지만 min interval (1 s) 안: 여전히 history 만
+    at = s_trace.size();
+    r = reading(FB_KEY_TEMPERATURE, 23.0f, 900);
+    CHECK_EQ(sensor_bus_publish(&bus, &r), 1);
+    CHECK_STR(sinks_since(at), "history");
+
+    // min interval 지남 + deadband 밖: 다시 전부
+    at = s_trace.size();
+    r = reading(FB_KEY_TEMPERATURE, 23.0f, 1000);
+    CHECK_EQ(sensor_bus_publish(&bus, &r), 3);
+    CHECK_STR(sinks_since(at), "history,matter,firebase");
+
+    // 값이 그대로여도 max interval (60 s) 이 지나면 보고
+    at = s_trace.size();
+    r = reading(FB_KEY_TEMPERATURE, 23.0f, 61000);
+    CHECK_EQ(sensor_bus_publish(&bus, &r), 3);
+
+    // matter 의 key filter 밖 (빛): history / firebase 만. 정책이 없는 key (0 deadband) 는 값이 바뀔 때만
+    at = s_trace.size();
+    r = reading(FB_KEY_LIGHT_INTENSITY, 100.0f, 62000);
+    CHECK_EQ(sensor_bus_publish(&bus, &r), 2);
+    CHECK_STR(sinks_since(at), "history,firebase");
+    at = s_trace.size();
+    r = reading(FB_KEY_LIGHT_INTENSITY, 100.0f, 63000);
+    CHECK_EQ(sensor_bus_publish(&bus, &r), 1);
+    CHECK_STR(sinks_since(at), "history");
+
+    // 보고 정책 상태는 sink 마다 따로: 늦게 구독한 sink 도 자기 상태로 첫 값부터 보고
+    sensor_sub_cfg_t late = { "late", sink, (void *)"late", 0, policies };
+    CHECK_EQ(sensor_bus_subscribe(&bus, &late), 3);
+    r = reading(FB_KEY_HUMIDITY, 40.0f, 64000);
+    CHECK_EQ(sensor_bus_publish(&bus, &r), 4);
+    at = s_trace.size();
+    r = reading(FB_KEY_HUMIDITY, 41.0f, 65000);  // deadband 2 안
+    CHECK_EQ(sensor_bus_publish(&bus, &r), 1);
+    CHECK_STR(sinks_since(at), "history");
+
+    // 모르는 key: 아무에게도 안 가고 seq 도 그대로
+    uint32_t seq = bus.seq;
+    r = reading(FB_KEY_COUNT, 1.0f, 66000);
+    CHECK_EQ(sensor_bus_publish(&bus, &r), 0);
+    CHECK_EQ(bus.seq, seq);
+
+    // seq 는 publish 마다 1씩, trace 의 seq 는 증가하는 순서
+    for (size_t i = 1; i < s_trace.size(); i++) CHECK(s_trace[i].seq >= s_trace[i - 1].seq);
+    CHECK_EQ(bus.seq, 9u);
+
+    // sink 별 counter
+    CHECK_EQ(bus.subs[0].delivered, 9u);
+    CHECK_EQ(bus.subs[0].filtered + bus.subs[0].limited, 0u);
+    CHECK_EQ(bus.subs[1].delivered, 4u);  // 온도 3 + 습도 1
+    CHECK_EQ(bus.subs[1].filtered, 2u);   // 빛 2
+    CHECK_EQ(bus.subs[1].limited, 3u);    // 온도 2 + 습도 1
+    CHECK_EQ(bus.subs[2].delivered, 5u);
+    CHECK_EQ(bus.subs[2].limited, 4u);
+    CHECK_EQ(bus.subs[3].delivered, 1u);
+    CHECK_EQ(bus.subs[1].state[FB_KEY_TEMPERATURE].emitted, 3u);
+
+    // 구독 한도, fn 없는 구독
+    sensor_sub_cfg_t none = { "none", NULL, NULL, 0, NULL };
+    CHECK_EQ(sensor_bus_subscribe(&bus, &none), -1);
+    while (bus.count < SENSOR_BUS_MAX_SUBS) CHECK(sensor_bus_subscribe(&bus, &history) >= 0);
+    CHECK_EQ(sensor_bus_subscribe(&bus, &history), -1);
+
+    return host_check_result("test_sensor_bus");
+}
@@ -0,0 +1,104 @@
+// sensor_filter: burst 평균 -> median-of-5 -> EMA 에 합성 노이즈 (백색 잡음 + mains hum + 모터 spike)를 넣고
+// 단계별 분산과 spike 제거를 확인. 커널 비용도 출력
+#include "host_check.h"
+#include "sensor_filter.h"
+#include <random>
+#include <string.h>
+
+#define FS_HZ         10000   // 채널당 변환 속도 (20 kHz / 2 채널)
+#define MAINS_HZ      60
+#define BURST_SAMPLES (FS_HZ / MAINS_HZ)
+#define TRUE_RAW      2000.0
+#define READS         2000
+
+static std::mt19937 s_rng(12345);
+static std::normal_distribution<double> s_white(0.0, 40.0);
+static std::uniform_real_distribution<double> s_uniform(0.0, 1.0);
+
+// 샘플 하나: 참값 + 백색 잡음 + mains hum (진폭 120, 위상 phase)
+static double sample(int i, double phase)
+{
+    return TRUE_RAW + s_white(s_rng) + 120.0 * sin(2 * M_PI * MAINS_HZ * i / FS_HZ + phase);
+}
+
+// burst 하나 = mains 한 주기 평균. spike면 burst 전체가 모터 노이즈에 걸린 것 (+700)
+static float burst(bool spike)
+{
+    double phase = s_uniform(s_rng) * 2 * M_PI;
+    double sum = 0;
+    for (int i = 0; i < BURST_SAMPLES; i++) sum += sample(i, phase);
+    return (float)(sum / BURST_SAMPLES + (spike ? 700.0 : 0.0));
+}
+
+struct stat_t {
+    double sum = 0, sum2 = 0, max_err = 0;
+    int n = 0;
+    void add(double x)
+    {
+        sum += x;
+        sum2 += x * x;
+        n++;
+        if (fabs(x - TRUE_RAW) > max_err) max_err = fabs(x - TRUE_RAW);
+    }
+    double mean() const { return sum / n; }
+    double var() const { return sum2 / n - mean() * mean(); }
+};
+
+int main()
+{
+    const sensor_filter_cfg_t cfg = { 5, 30, 0.3f };
+    sensor_filter_t state = {};
+    stat_t raw, avg, med, out;
+
+    for (int r = 0; r < READS; r++) {
+        raw.add(sample(r * 7, 0));
+
+        // read 하나: burst 5개 중 spike는 많아야 하나 (burst 간격이 spike보다 김), 20% 확률
+        int spike_at = s_uniform(s_rng) < 0.2 ? (int)(s_uniform(s_rng) * cfg.median_n) : -1;
+        float bursts[SENSOR_FILTER_MAX_MEDIAN];
+        for (int b = 0; b < cfg.median_n; b++) {
+            bursts[b] = burst(b == spike_at);
+            avg.add(bursts[b]);
+        }
+        float m = sensor_filter_median(bursts, cfg.median_n);
+        med.add(m);
+        out.add(sensor_filter_ema(&state, cfg.ema_alpha, m));
+    }
+
+    printf("variance raw=%.1f burst=%.1f median=%.2f ema=%.2f, max |err| burst=%.0f median=%.1f ema=%.1f\n",
+           raw.var(), avg.var(), med.var(), out.var(), avg.max_err, med.max_err, out.max_err);
+
+    // 한 주기 평균으로 hum이 상쇄되고 백색 잡음은 1/N
+    CHECK(avg.n == READS * cfg.median_n);
+    CHECK(raw.var() > 40 * 40);
+    // median이 spike를 통째로 버림: 참값에서 백색 잡음 몇 sigma 안
+    CHECK(med.max_err < 30);
+    CHECK_NEAR(med.mean(), TRUE_RAW, 1.0);
+    // spike가 섞인 burst 평균은 700 가까이 튐
+    CHECK(avg.max_err > 600);
+    // EMA(0.3)는 분산을 alpha/(2-alpha) ~ 0.18배로
+    CHECK(out.var() < med.var() * 0.3);
+    CHECK(out.var() < raw.var() / 100);
+
+    // 짝수 N은 가운데 두 값 평균, N=1은 그대로
+    float even[] = { 4, 1, 3, 2 };
+    CHECK_NEAR(sensor_filter_median(even, 4), 2.5, 0);
+    float one[] = { 7 };
+    CHECK_NEAR(sensor_filter_median(one, 1), 7, 0);
+
+    // 첫 값은 EMA 없이 그대로, alpha 1이면 필터 없음
+    sensor_filter_t s = {};
+    CHECK_NEAR(sensor_filter_ema(&s, 0.3f, 100), 100, 0);
+    CHECK_NEAR(sensor_filter_ema(&s, 0.3f, 200), 130, 1e-4);
+    CHECK_NEAR(sensor_filter_ema(&s, 1.0f, 50), 50, 0);
+
+    // 커널 비용 (median-of-5 + EMA 한 번)
+    float sink = 0;
+    double ns = host_bench_ns(1000000, [&](long i) {
+        float v[5] = { (float)(i & 7), 3, (float)(i & 3), 5, 1 };
+        sink += sensor_filter_ema(&s, 0.3f, sensor_filter_median(v, 5));
+    });
+    printf("median5+ema: %.1f ns/read (sink %g)\n", ns, (double)sink);
+
+    return host_check_result("test_sensor_filter");
+}
@@ -0,0 +1,69 @@
+// 센서 태스크 샘플 함수 (cds / soil / dht11)를 ADC / DHT shim 위에서 돌려서
+// 변환 결과와 bus로 publish되는 record를 확인
+#include "host_check.h"
+#include "host_shims.h"
+#include "cds_task.h"
+#include "soil_task.h"
+#include "dht11_task.h"
+#include "sensor_bus.h"
+#include <hal/adc_types.h>
+#include "sensor_convert.h"
+#include <string.h>
+
+struct published_t {
+    fb_key_t key;
+    uint16_t endpoint_id;
+    float    value;
+};
+
+static published_t s_pub[8];
+static int s_pub_count;
+
+// 펌웨어에서는 app_main이 구현 (bus로 publish)
+void sensor_publish(fb_key_t key, uint16_t endpoint_id, float value)
+{
+    if (s_pub_count < 8) s_pub[s_pub_count++] = { key, endpoint_id, value };
+}
+
+int main()
+{
+    uint16_t cds_ep = 5, soil_ep = 6;
+    uint16_t dht_eps[2] = { 3, 4 };
+
+    // CdS: raw 2048 -> 1650 mV (선형 shim 테이블) -> lux 테이블
+    host_adc_set_raw(ADC_CHANNEL_6, 2048);
+    cds_sample(&cds_ep);
+    CHECK_EQ(s_pub_count, 1);
+    CHECK_EQ(s_pub[0].key, FB_KEY_LIGHT_INTENSITY);
+    CHECK_EQ(s_pub[0].endpoint_id, cds_ep);
+    CHECK_NEAR(s_pub[0].value, cds_mv_to_lux(2048 * 3300 / 4095), 0.01);
+
+    // soil: raw 1241 -> 1000 mV -> 100 - 1000/3300*100 %
+    host_adc_set_raw(ADC_CHANNEL_7, 1241);
+    soil_moisture_sample(&soil_ep);
+    CHECK_EQ(s_pub_count, 2);
+    CHECK_EQ(s_pub[1].key, FB_KEY_SOIL_MOISTURE);
+    CHECK_NEAR(s_pub[1].value, 100.0 - 1000.0 / 3300.0 * 100.0, 0.01);
+
+    // ADC 읽기 실패면 아무것도 publish하지 않음
+    host_adc_set_raw(ADC_CHANNEL_7, -1);
+    soil_moisture_sample(&soil_ep);
+    CHECK_EQ(s_pub_count, 2);
+
+    // DHT11: x10 정수 -> 온도 / 습도 두 record
+    host_dht_set(ESP_OK, 456, 231);
+    dht11_sample(dht_eps);
+    CHECK_EQ(s_pub_count, 4);
+    CHECK_EQ(s_pub[2].key, FB_KEY_TEMPERATURE);
+    CHECK_EQ(s_pub[2].endpoint_id, 3);
+    CHECK_NEAR(s_pub[2].value, 23.1, 1e-4);
+    CHECK_EQ(s_pub[3].key, FB_KEY_HUMIDITY);
+    CHECK_EQ(s_pub[3].endpoint_id, 4);
+    CHECK_NEAR(s_pub[3].value, 45.6, 1e-4);
+
+    host_dht_set(ESP_ERR_TIMEOUT, 0, 0);
+    dht11_sample(dht_eps);
+    CHECK_EQ(s_pub_count, 4);
+
+    return host_check_result("test_sensor_path");
+}
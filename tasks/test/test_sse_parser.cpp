@@ -0,0 +1,142 @@
+// sse_parser: Firebase 스트림 모양의 입력을 모든 byte 위치에서 두 chunk로 (그리고 1 byte씩) 잘라 넣어도
+// 한 번에 넣은 것과 같은 이벤트가 나오는지, 여러 줄 data / comment / CR·CRLF 줄 끝 / 너무 긴 data / reset
+#include "host_check.h"
+#include "sse_parser.h"
+#include <string>
+#include <vector>
+
+struct event_t {
+    std::string event, data;
+    bool operator==(const event_t &o) const { return event == o.event && data == o.data; }
+};
+
+static void collect(void *ctx, const char *event, const char *data, size_t len)
+{
+    ((std::vector<event_t> *)ctx)->push_back({ event, std::string(data, len) });
+}
+
+static std::vector<event_t> feed_split(const std::string &in, std::vector<size_t> cuts)
+{
+    std::vector<event_t> out;
+    static sse_parser_t p;
+    sse_parser_init(&p, collect, &out);
+    size_t at = 0;
+    cuts.push_back(in.size());
+    for (size_t cut : cuts) {
+        // chunk 는 feed 뒤에 사라짐: 복사본을 넘기고 바로 덮어씀
+        std::string chunk = in.substr(at, cut - at);
+        sse_parser_feed(&p, chunk.data(), chunk.size());
+        std::fill(chunk.begin(), chunk.end(), '#');
+        at = cut;
+    }
+    return out;
+}
+
+static const char k_stream[] =
+    ": connected\n"
+    "event: put\n"
+    "data: {\"path\":\"/\",\"data\":{\"ledStatus\":1,\"pumpStatus\":0}}\n"
+    "\n"
+    "event: keep-alive\n"
+    "data: null\n"
+    "\n"
+    ":ping\r\n"
+    "event: patch\r\n"
+    "data: {\"path\":\"/\",\r\n"
+    "data:\"data\":{\"heatLedStatus\":1}}\r\n"
+    "\r\n"
+    "id: 7\r"
+    "data\r"
+    "\r"
+    "event: put\n"
+    "data:  two spaces\n"
+    "retry: 1000\n"
+    "\n"
+    "data: no event name\n"
+    "\n"
+    "event: dangling\n"
+    "\n"
+    "data: unterminated";
+
+int main()
+{
+    const std::string in = k_stream;
+    const std::vector<event_t> want = {
+        { "put", "{\"path\":\"/\",\"data\":{\"ledStatus\":1,\"pumpStatus\":0}}" },
+        { "keep-alive", "null" },
+        { "patch", "{\"path\":\"/\",\n\"data\":{\"heatLedStatus\":1}}" },
+        { "message", "" },                 // 값 없는 "data" 줄도 이벤트 (빈 data)
+        { "put", " two spaces" },          // ':' 뒤 공백은 하나만 뗌
+        { "message", "no event name" },
+    };                                     // data 없는 이벤트 / 끝나지 않은 이벤트는 안 나옴
+
+    CHECK(feed_split(in, {}) == want);
+
+    // 모든 byte 위치에서 두 chunk 로
+    int bad = 0;
+    for (size_t i = 1; i < in.size(); i++) {
+        if (!(feed_split(in, { i }) == want)) bad++;
+    }
+    CHECK_EQ(bad, 0);
+
+    // 모든 (i, j) 위치에서 세 chunk 로 (CRLF 가 chunk 세 개에 걸치는 경우 포함)
+    bad = 0;
+    for (size_t i = 1; i < in.size(); i += 3) {
+        for (size_t j = i + 1; j < in.size(); j += 2) {
+            if (!(feed_split(in, { i, j }) == want)) bad++;
+        }
+    }
+    CHECK_EQ(bad, 0);
+
+    // 1 byte 씩
+    {
+        std::vector<size_t> cuts;
+        for (size_t i = 1; i < in.size(); i++) cuts.push_back(i);
+        CHECK(feed_split(in, cuts) == want);
+    }
+
+    // comment 만 있는 스트림 (keep-alive) 은 이벤트 없음
+    CHECK(feed_split(":a\n:b\n\n:c\r\n\r\n", {}).empty());
+
+    // 너무 긴 data: 그 이벤트만 버리고 다음 이벤트는 정상. chunk 안에서 끝나든 경계에 걸치든 같음
+    {
+        std::string big = "data: " + std::string(SSE_DATA_MAX + 1, 'x') + "\n\ndata: ok\n\n";
+        for (size_t cut : { (size_t)0, (size_t)10, (size_t)SSE_DATA_MAX + 8, big.size() - 3 }) {
+            std::vector<event_t> out;
+            sse_parser_t p;
+            sse_parser_init(&p, collect, &out);
+            if (cut) {
+                sse_parser_feed(&p, big.data(), cut);
+                sse_parser_feed(&p, big.data() + cut, big.size() - cut);
+            } else {
+                sse_parser_feed(&p, big.data(), big.size());
+            }
+            CHECK_EQ(out.size(), 1u);
+            CHECK(!out.empty() && out[0].data == "ok");
+            CHECK_EQ(p.events, 1);
+            CHECK(p.dropped >= 1);
+        }
+        // 여러 줄을 합쳐서 넘치는 경우
+        std::string lines;
+        for (int i = 0; i < 8; i++) lines += "data: " + std::string(SSE_DATA_MAX / 8, 'y') + "\n";
+        lines += "\ndata: ok\n\n";
+        std::vector<event_t> out = feed_split(lines, { 100, 300 });
+        CHECK_EQ(out.size(), 1u);
+    }
+
+    // reset: 진행 중이던 줄/이벤트는 버리고 새 연결부터
+    {
+        std::vector<event_t> out;
+        sse_parser_t p;
+        sse_parser_init(&p, collect, &out);
+        const char a[] = "event: put\ndata: old";
+        sse_parser_feed(&p, a, sizeof(a) - 1);
+        sse_parser_reset(&p);
+        const char b[] = "data: new\n\n";
+        sse_parser_feed(&p, b, sizeof(b) - 1);
+        CHECK_EQ(out.size(), 1u);
+        CHECK(out[0] == (event_t{ "message", "new" }));
+    }
+
+    return host_check_result("test_sse_parser");
+}
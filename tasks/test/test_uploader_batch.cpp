@@ -0,0 +1,86 @@
+// sensor lane: batch window 안에 들어온 fb_update()들이 PATCH 하나 (multi-key body)로 합쳐지는지,
+// key가 max_keys개 모이면 window를 기다리지 않는지 확인
+#include "host_check.h"
+#include "host_shims.h"
+#include "firebase.h"
+#include "sdkconfig.h"
+#include <esp_timer.h>
+#include <string.h>
+#include <thread>
+
+// plant_data.json으로 간 요청만 (diagnostics 등은 제외)
+static int data_requests(host_http_req_t *last)
+{
+    int n = 0;
+    for (int i = 0; i < host_http_request_count(); i++) {
+        host_http_req_t req;
+        if (host_http_get_request(i, &req) && strstr(req.url, "/plant_data.json")) {
+            n++;
+            if (last) *last = req;
+        }
+    }
+    return n;
+}
+
+static void settle(int ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+int main()
+{
+    host_dns_set("smart-plant-app-1-default-rtdb.asia-southeast1.firebasedatabase.app", "10.0.0.7");
+    fb_queue_init();
+    firebase_uploader_start();
+
+    // burst: 같은 key를 덮어쓴 값은 마지막 것만, body는 key 순서 (fb_key_t)
+    int64_t t0 = esp_timer_get_time();
+    fb_update(FB_KEY_SOIL_MOISTURE, 50.0f);
+    fb_update(FB_KEY_TEMPERATURE, 23.1f);
+    fb_update(FB_KEY_HUMIDITY, 45.6f);
+    fb_update(FB_KEY_TEMPERATURE, 23.4f);
+    settle(CONFIG_FB_BATCH_WINDOW_MS * 4);
+
+    host_http_req_t req;
+    CHECK_EQ(data_requests(&req), 1);
+    CHECK_STR(req.body, "{\"temperature\":23.40,\"humidity\":45.60,\"soilMoisture\":50.00}");
+    CHECK_EQ(req.body_len, (int)strlen(req.body));
+    CHECK(req.at_us - t0 >= CONFIG_FB_BATCH_WINDOW_MS * 1000);  // window까지 모았다가 보냄
+
+    fb_metrics_t m;
+    fb_get_metrics(&m);
+    CHECK_EQ(m.updates, 4);
+    CHECK_EQ(m.overwrites, 1);
+    CHECK_EQ(m.pending_hwm[FB_LANE_SENSOR], 3);
+
+    // sensor key 8개 (= CONFIG_FB_BATCH_MAX_KEYS)가 모이면 바로 보냄
+    t0 = esp_timer_get_time();
+    fb_update(FB_KEY_TEMPERATURE, 20.0f);
+    fb_update(FB_KEY_HUMIDITY, 40.0f);
+    fb_update(FB_KEY_SOIL_MOISTURE, 30.0f);
+    fb_update(FB_KEY_LIGHT_INTENSITY, 812.5f);
+    fb_update(FB_KEY_HEAP_MIN_FREE, 81234.0f);
+    fb_update(FB_KEY_HEAP_LARGEST_BLOCK, 65536.0f);
+    fb_update(FB_KEY_HEAP_FRAG_PCT, 19.6f);
+    fb_update(FB_KEY_STACK_FREE_UPLOADER, 1024.0f);
+    settle(CONFIG_FB_BATCH_WINDOW_MS * 4);
+
+    CHECK_EQ(data_requests(&req), 2);
+    CHECK_STR(req.body,
+              "{\"temperature\":20.00,\"humidity\":40.00,\"soilMoisture\":30.00,\"lightIntensity\":812.50,"
+              "\"heapMinFree\":81234,\"heapLargest\":65536,\"heapFragPct\":20,\"stackFreeUploader\":1024}");
+    CHECK(req.at_us - t0 < CONFIG_FB_BATCH_WINDOW_MS * 1000);
+
+    // control key는 sensor window와 상관없이 따로 바로
+    fb_update(FB_KEY_TEMPERATURE, 21.0f);
+    fb_update(FB_KEY_LED_STATUS, 0);
+    settle(CONFIG_FB_BATCH_WINDOW_MS * 4);
+    CHECK_EQ(data_requests(NULL), 4);
+    for (int i = 0, seen = 0; i < host_http_request_count(); i++) {
+        if (!host_http_get_request(i, &req) || !strstr(req.url, "/plant_data.json")) continue;
+        if (++seen == 3) CHECK_STR(req.body, "{\"ledStatus\":false}");
+        if (seen == 4) CHECK_STR(req.body, "{\"temperature\":21.00}");
+    }
+
+    return host_check_result("test_uploader_batch");
+}
@@ -0,0 +1,98 @@
+// uploader가 client(TLS 세션) 하나를 유지하면서 보내는지, 끊기면 한 번 다시 연결하는지,
+// 요청마다 https latency를 기록하는지 가짜 esp_http_client 위에서 확인
+#include "host_check.h"
+#include "host_shims.h"
+#include "firebase.h"
+#include "latency.h"
+#include <esp_http_client.h>
+#include <string.h>
+#include <thread>
+
+#define HOST "smart-plant-app-1-default-rtdb.asia-southeast1.firebasedatabase.app"
+
+// 가짜 client가 요청을 기록한 뒤 uploader가 응답을 처리(metrics)할 때까지
+static bool wait_handled(int expect_total)
+{
+    if (!host_http_wait_requests(expect_total, 3000)) return false;
+    for (int i = 0; i < 1000; i++) {
+        fb_metrics_t m;
+        fb_get_metrics(&m);
+        if ((int)m.requests >= expect_total) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+// control key는 deadline 0이라 fb_update 뒤 바로 PATCH 하나
+static bool send_control(float value, int expect_total)
+{
+    fb_update(FB_KEY_LED_STATUS, value);
+    return wait_handled(expect_total);
+}
+
+int main()
+{
+    host_dns_set(HOST, "10.0.0.7");
+    host_http_set_latency_ms(5);
+    fb_queue_init();
+    firebase_uploader_start();
+
+    // 첫 요청: client init 한 번 + 연결 한 번, 캐시한 IP로 연결하고 Host 헤더는 host 이름
+    CHECK(send_control(1, 1));
+    host_http_req_t req;
+    CHECK(host_http_get_request(0, &req));
+    CHECK_STR(req.url, "https://10.0.0.7/plant_data.json");
+    CHECK_STR(req.host_header, HOST);
+    CHECK_STR(req.body, "{\"ledStatus\":true}");
+
+    // 이어지는 요청은 같은 client / 같은 연결 (handshake 없음, DNS 다시 안 함)
+    for (int i = 0; i < 5; i++) CHECK(send_control(i & 1 ? 1 : 0, 2 + i));
+    host_http_stats_t hs;
+    host_http_get_stats(&hs);
+    CHECK_EQ(hs.inits, 1);
+    CHECK_EQ(hs.connects, 1);
+    CHECK_EQ(hs.closes, 0);
+    CHECK_EQ(hs.performs, 6);
+    CHECK_EQ(host_dns_lookups(), 1);
+
+    // 서버가 idle 연결을 끊음: 첫 perform 실패 -> close 후 같은 client로 재연결해서 성공
+    host_http_push_result(ESP_ERR_HTTP_CONNECT, 0);
+    CHECK(send_control(1, 7));
+    host_http_get_stats(&hs);
+    CHECK_EQ(hs.inits, 1);
+    CHECK_EQ(hs.cleanups, 0);
+    CHECK_EQ(hs.closes, 1);
+    CHECK_EQ(hs.connects, 2);
+    CHECK_EQ(host_dns_lookups(), 2);  // 실패하면 캐시한 주소도 버림
+
+    fb_metrics_t m;
+    fb_get_metrics(&m);
+    CHECK_EQ(m.requests, 7);
+    CHECK_EQ(m.retries, 1);
+    CHECK_EQ(m.transport_failures, 0);
+    CHECK_EQ(m.connects, 2);
+
+    // 재시도까지 실패: 값은 슬롯으로 돌아가고 FB_RETRY_MS 뒤 (같은 client로) 다시 보냄
+    host_http_push_result(ESP_ERR_HTTP_CONNECT, 0);
+    host_http_push_result(ESP_ERR_HTTP_CONNECT, 0);
+    fb_update(FB_KEY_PUMP_STATUS, 1);
+    CHECK(!host_http_wait_requests(8, 1000));
+    CHECK(wait_handled(8));
+    CHECK(host_http_get_request(7, &req));
+    CHECK_STR(req.body, "{\"pumpStatus\":true}");
+    fb_get_metrics(&m);
+    CHECK_EQ(m.transport_failures, 1);
+    host_http_get_stats(&hs);
+    CHECK_EQ(hs.inits, 1);
+
+    // 응답을 받은 요청마다 https 단계 기록 (perform 5 ms)
+    lat_hist_t h;
+    latency_get(LAT_STAGE_HTTPS, &h);
+    CHECK_EQ(h.count, 8);
+    CHECK(h.max_us >= 5000);
+    CHECK(h.sum_us >= 8 * 5000);
+    latency_get(LAT_STAGE_QUEUE_WAIT, &h);
+    CHECK_EQ(h.count, 9);  // 실패한 batch도 슬롯에서 꺼낼 때 한 번
+
+    return host_check_result("test_uploader_keepalive");
+}
@@ -0,0 +1,85 @@
+// key 슬롯 mailbox에 여러 태스크가 동시에 fb_update() 할 때:
+// 값이 key마다 순서대로만 나가고 (이전 값으로 되돌아가지 않음), 마지막 값은 반드시 보내지고, 셈이 맞는지 확인
+#include "host_check.h"
+#include "host_shims.h"
+#include "firebase.h"
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#define PRODUCERS   4
+#define UPDATES     20000   // producer 하나가 보내는 값 수 (1..UPDATES)
+
+static const fb_key_t s_keys[PRODUCERS] = {
+    FB_KEY_TEMPERATURE, FB_KEY_HUMIDITY, FB_KEY_SOIL_MOISTURE, FB_KEY_LIGHT_INTENSITY,
+};
+
+// body에서 "name":<number> 를 찾음 (없으면 -1)
+static double body_value(const char *body, const char *name)
+{
+    char pat[32];
+    snprintf(pat, sizeof(pat), "\"%s\":", name);
+    const char *p = strstr(body, pat);
+    return p ? strtod(p + strlen(pat), NULL) : -1;
+}
+
+int main()
+{
+    host_dns_set("smart-plant-app-1-default-rtdb.asia-southeast1.firebasedatabase.app", "10.0.0.7");
+    host_http_set_latency_ms(1);
+    fb_queue_init();
+    firebase_uploader_start();
+
+    // producer마다 자기 key에 1..UPDATES, 하나는 control key도 같이 토글
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; p++) {
+        producers.emplace_back([p] {
+            for (int v = 1; v <= UPDATES; v++) {
+                fb_update(s_keys[p], (float)v);
+                if (p == 0 && v % 1000 == 0) fb_update(FB_KEY_PUMP_STATUS, (float)((v / 1000) & 1));
+                // 전송 중에도 계속 들어오도록 조금씩 쉬어감 (약 0.4 s 동안)
+                if (v % 50 == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+    }
+    for (auto &t : producers) t.join();
+
+    // 마지막 값이 나갈 때까지 (batch window + 진행 중인 요청)
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    double last[PRODUCERS] = {};
+    int sent[PRODUCERS] = {};
+    double last_pump = -1;
+    for (int i = 0; i < host_http_request_count(); i++) {
+        host_http_req_t req;
+        if (!host_http_get_request(i, &req) || !strstr(req.url, "/plant_data.json")) continue;
+        for (int p = 0; p < PRODUCERS; p++) {
+            double v = body_value(req.body, fb_key_table[s_keys[p]].name);
+            if (v < 0) continue;
+            CHECK(v > last[p]);  // 같은 key는 증가하는 순서로만
+            last[p] = v;
+            sent[p]++;
+        }
+        if (strstr(req.body, "\"pumpStatus\":true")) last_pump = 1;
+        if (strstr(req.body, "\"pumpStatus\":false")) last_pump = 0;
+    }
+    for (int p = 0; p < PRODUCERS; p++) {
+        CHECK_EQ(last[p], UPDATES);
+        CHECK(sent[p] >= 1 && sent[p] <= UPDATES);
+    }
+    CHECK_EQ(last_pump, (UPDATES / 1000) & 1);
+
+    fb_metrics_t m;
+    fb_get_metrics(&m);
+    CHECK_EQ(m.updates, PRODUCERS * UPDATES + UPDATES / 1000);
+    CHECK_EQ(m.drops, 0);
+    CHECK(m.overwrites > 0);
+    CHECK(m.pending_hwm[FB_LANE_SENSOR] <= 4);
+    CHECK_EQ(m.transport_failures, 0);
+    printf("%lu updates -> %lu requests, %lu overwritten before send\n",
+           (unsigned long)m.updates, (unsigned long)m.requests, (unsigned long)m.overwrites);
+    CHECK(m.requests >= 4);  // producer가 도는 동안 여러 batch가 나감
+
+    return host_check_result("test_uploader_stress");
+}
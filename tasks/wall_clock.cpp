@@ -0,0 +1,78 @@
+#include "wall_clock.h"
+#include "sdkconfig.h"
+#include <esp_log.h>
+#include <esp_sntp.h>
+#include <esp_timer.h>
+#include <nvs.h>
+#include <time.h>
+
+static const char *TAG = "wall_clock";
+
+// 이보다 이전이면 벽시계가 아님 (2024-01-01 00:00 UTC)
+#define WALL_CLOCK_MIN_UNIX 1704067200
+
+static uint16_t s_boot;
+static volatile bool s_synced;   // SNTP 콜백 (lwIP 태스크) 에서 씀
+
+void wall_clock_init(void)
+{
+    nvs_handle_t h;
+    if (nvs_open("wall_clock", NVS_READWRITE, &h) != ESP_OK) {
+        ESP_LOGW(TAG, "nvs open failed, boot id stays 0");
+        return;
+    }
+    uint32_t boot = 0;
+    nvs_get_u32(h, "boot", &boot);
+    boot++;
+    if (nvs_set_u32(h, "boot", boot) != ESP_OK || nvs_commit(h) != ESP_OK) {
+        ESP_LOGW(TAG, "boot counter not saved");
+    }
+    nvs_close(h);
+    s_boot = (uint16_t)boot;
+    ESP_LOGI(TAG, "boot %u", (unsigned)s_boot);
+}
+
+static void on_sync(struct timeval *tv)
+{
+    s_synced = true;
+    ESP_LOGI(TAG, "time synced: %lld", (long long)tv->tv_sec);
+}
+
+void wall_clock_start_sntp(void)
+{
+    if (esp_sntp_enabled()) return;
+    esp_sntp_setoperatingmode(ESP_SNTP_OPMODE_POLL);
+    esp_sntp_setservername(0, CONFIG_SNTP_SERVER);
+    sntp_set_time_sync_notification_cb(on_sync);
+    esp_sntp_init();
+}
+
+uint16_t wall_clock_boot_id(void)
+{
+    return s_boot;
+}
+
+bool wall_clock_valid(void)
+{
+    return s_synced || time(NULL) >= WALL_CLOCK_MIN_UNIX;
+}
+
+static uint32_t uptime_s(void)
+{
+    return (uint32_t)(esp_timer_get_time() / 1000000);
+}
+
+wall_stamp_t wall_clock_now(void)
+{
+    wall_stamp_t s = {};
+    s.boot = s_boot;
+    s.wall = wall_clock_valid();
+    s.t = s.wall ? (uint32_t)time(NULL) : uptime_s();
+    return s;
+}
+
+uint32_t wall_clock_from_uptime(uint32_t uptime)
+{
+    if (!wall_clock_valid()) return 0;
+    return (uint32_t)time(NULL) - (uptime_s() - uptime);
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+// 기록용 시각. SNTP 로 벽시계가 맞춰지기 전의 time(NULL) 은 1970년부터 센 uptime 이라
+// 부팅마다 같은 값이 반복됨 -> 벽시계가 없으면 (부팅 번호, 부팅 후 초) 로 남김.
+// 부팅 번호는 NVS 에 저장된 카운터 (부팅마다 +1)
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t t;      // wall ? unix time : 부팅 후 초
+    uint16_t boot;   // 부팅 번호
+    bool     wall;
+} wall_stamp_t;
+
+// NVS 부팅 번호 증가. nvs_flash_init() 뒤, 로그/history 를 쓰기 전에
+void wall_clock_init(void);
+
+// SNTP 시작. 네트워크 스택이 올라온 뒤 (esp_matter::start 이후)
+void wall_clock_start_sntp(void);
+
+uint16_t wall_clock_boot_id(void);
+
+// 벽시계가 맞는지 (SNTP 동기화 완료, 또는 리셋 전에 맞춰둔 시각이 남아있음)
+bool wall_clock_valid(void);
+
+wall_stamp_t wall_clock_now(void);
+
+// 이번 부팅의 "부팅 후 초" 를 unix time 으로. 벽시계가 아직 없으면 0
+uint32_t wall_clock_from_uptime(uint32_t uptime_s);
+
+#ifdef __cplusplus
+}
+#endif
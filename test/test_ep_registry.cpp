@@ -0,0 +1,71 @@
+// ep_registry: 등록 / 조회, 범위 밖 id, root endpoint, 같은 id 나 key 두 번, key -> endpoint 역방향
+#include "host_check.h"
+#include "ep_registry.h"
+
+static int s_power_calls;
+static bool s_power;
+
+static void set_power(bool on)
+{
+    s_power_calls++;
+    s_power = on;
+}
+
+int main()
+{
+    // 빈 표
+    CHECK(ep_registry_get(1) == NULL);
+    CHECK_EQ(ep_registry_endpoint_of(FB_KEY_LED_STATUS), 0);
+
+    // actuator: 역할 / key / 드라이버, Matter 속성 없음
+    ep_entry_t *led = ep_registry_add_actuator(1, FB_KEY_LED_STATUS, set_power);
+    CHECK(led != NULL);
+    CHECK(ep_registry_get(1) == led);
+    CHECK_EQ(led->role, EP_ROLE_ACTUATOR);
+    CHECK_EQ(led->key, FB_KEY_LED_STATUS);
+    CHECK_EQ(led->attr, -1);
+    ep_registry_get(1)->set_power(true);
+    CHECK_EQ(s_power_calls, 1);
+    CHECK(s_power);
+    CHECK_EQ(ep_registry_endpoint_of(FB_KEY_LED_STATUS), 1);
+
+    // sensor: history / scale / 부호, attr 는 bind 전까지 -1
+    ep_entry_t *temp = ep_registry_add_sensor(4, FB_KEY_TEMPERATURE, HISTORY_TEMPERATURE, 100, true);
+    CHECK(temp != NULL);
+    CHECK_EQ(temp->role, EP_ROLE_SENSOR);
+    CHECK_EQ(temp->history, HISTORY_TEMPERATURE);
+    CHECK_NEAR(temp->attr_scale, 100, 0);
+    CHECK(temp->attr_signed);
+    CHECK_EQ(temp->attr, -1);
+    CHECK(temp->set_power == NULL);
+    CHECK_EQ(ep_registry_endpoint_of(FB_KEY_TEMPERATURE), 4);
+
+    // 중간 id 는 비어 있음
+    CHECK(ep_registry_get(2) == NULL);
+    CHECK(ep_registry_get(3) == NULL);
+
+    // 같은 id 두 번 / 같은 key 를 다른 endpoint 에: 거절하고 기존 항목은 그대로
+    CHECK(ep_registry_add_actuator(1, FB_KEY_PUMP_STATUS, set_power) == NULL);
+    CHECK(ep_registry_add_sensor(1, FB_KEY_HUMIDITY, HISTORY_HUMIDITY, 100, false) == NULL);
+    CHECK(ep_registry_add_actuator(5, FB_KEY_LED_STATUS, set_power) == NULL);
+    CHECK_EQ(ep_registry_get(1)->key, FB_KEY_LED_STATUS);
+    CHECK_EQ(ep_registry_endpoint_of(FB_KEY_LED_STATUS), 1);
+    CHECK(ep_registry_get(5) == NULL);
+    CHECK_EQ(ep_registry_endpoint_of(FB_KEY_PUMP_STATUS), 0);
+
+    // root endpoint 0, 범위 밖 id, 없는 key
+    CHECK(ep_registry_add_actuator(0, FB_KEY_PUMP_STATUS, set_power) == NULL);
+    CHECK(ep_registry_add_actuator(EP_REGISTRY_MAX_ENDPOINTS, FB_KEY_PUMP_STATUS, set_power) == NULL);
+    CHECK(ep_registry_add_sensor(6, FB_KEY_COUNT, HISTORY_LIGHT, 1, false) == NULL);
+    CHECK(ep_registry_get(0) == NULL);
+    CHECK(ep_registry_get(EP_REGISTRY_MAX_ENDPOINTS) == NULL);
+    CHECK(ep_registry_get(UINT16_MAX) == NULL);
+    CHECK_EQ(ep_registry_endpoint_of(FB_KEY_COUNT), 0);
+    CHECK_EQ(ep_registry_endpoint_of((fb_key_t)-1), 0);
+
+    // 마지막 id 까지 채울 수 있음
+    CHECK(ep_registry_add_actuator(EP_REGISTRY_MAX_ENDPOINTS - 1, FB_KEY_PUMP_STATUS, set_power) != NULL);
+    CHECK_EQ(ep_registry_endpoint_of(FB_KEY_PUMP_STATUS), EP_REGISTRY_MAX_ENDPOINTS - 1);
+
+    return host_check_result("test_ep_registry");
+}